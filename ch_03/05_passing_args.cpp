@@ -5,6 +5,8 @@
 #include <vector>
 #include <functional> // std::ref(), std::cref() define in functional
 
+#include "include/int_format.hpp"
+
 // std::ref(), std::cref()
 // Helper functions are used to generate std::reference_wrapper objects
 // which wrap a reference in a copyable and assignable object
@@ -76,14 +78,14 @@ void modifyValues(std::string& str, int& val) {
 
 /**
  * 03. Passing by const-reference
+ *
+ * - The whole vector is formatted into one buffer and emitted through a
+ *   single sync_cout temporary, so the line is written atomically
+ *   (see include/int_format.hpp and 12_int_format.cpp)
  */
 
 void printVector(const std::vector<int>& vec) {
-    sync_cout << "Vector: ";
-    for (int num: vec) {
-        sync_cout << num << " ";
-    }
-    sync_cout << std::endl;
+    sync_cout << "Vector: " << async::format_ints_parallel(vec) << std::endl;
 }
 
 /**
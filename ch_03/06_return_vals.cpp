@@ -4,6 +4,8 @@
 #include <syncstream>
 #include <thread>
 
+#include "include/fast_rng.hpp"
+
 #define sync_cout std::osyncstream(std::cout)
 
 using namespace std::chrono_literals;
@@ -13,9 +15,10 @@ namespace {
 };
 
 
+// rand() serializes callers on a global lock; thread_rng() is per-thread
 void func(int& result) {
     std::this_thread::sleep_for(1s);
-    result = 1 + (rand() % 10);
+    result = 1 + static_cast<int>(async::random_below(10));
 }
 
 int main() {
@@ -28,6 +31,7 @@ int main() {
     sync_cout << "Result: " << result << std::endl;
 
     return 0;
+}
 
 /**
  * @brief Unnamed (anonymous) namespace in C++.
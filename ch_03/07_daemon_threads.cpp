@@ -1,31 +1,39 @@
 #include <iostream>
 #include <syncstream>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
 #include <thread>
 
+#include "include/service_registry.hpp"
+
 #define sync_cout std::osyncstream(std::cout)
 
 using namespace std::chrono_literals;
 
-namespace {
-    int timeout = 3;
-}
-
-void daemonThread() {
+void daemonThread(std::stop_token token) {
     sync_cout << "Daemon thread starting ...\n";
-    while (timeout-- > 0) {
+    std::mutex mtx;
+    std::condition_variable_any cv;
+    std::unique_lock<std::mutex> lock(mtx);
+    for (int remaining = 3; remaining > 0; --remaining) {
         sync_cout << "Daemon thread running ...\n";
-        std::this_thread::sleep_for(1s);
+        // Sleeps 1s, but wakes as soon as stop is requested
+        cv.wait_for(lock, token, 1s, [] { return false; });
+        if (token.stop_requested()) break;
     }
     sync_cout << "Daemon thread exiting ...\n";
 }
 
 int main() {
     sync_cout << "Main thread starting ...\n";
-    std::thread daemon(daemonThread);
-    daemon.detach();
+    async::service_registry services;
+    services.start("daemon", daemonThread, [] { sync_cout << "Daemon thread draining ...\n"; });
 
-    std::this_thread::sleep_for(std::chrono::seconds(timeout + 1));
-    sync_cout << "Main thread exiting ...\n";
+    std::this_thread::sleep_for(1500ms);   // main's own work
+
+    auto report = services.shutdown(2s);
+    sync_cout << "Main thread exiting (shutdown took " << report.elapsed.count() << "ms) ...\n";
     return 0;
-}
\ No newline at end of file
+}
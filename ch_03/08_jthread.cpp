@@ -4,6 +4,8 @@
 #include <thread>
 #include <functional>
 
+#include "include/lifecycle_stats.hpp"
+#include "include/thread_registry.hpp"
 
 #define sync_cout std::osyncstream(std::cout)
 
@@ -37,19 +39,31 @@ using namespace std::chrono_literals;
 // };
 
 // Using perfect-forwarding without std::function
+// The thread registers itself under `name`, which also becomes its OS name.
+// Start latency, run time and join wait are recorded per name when
+// lifecycle stats are enabled (ASYNC_LIFECYCLE_STATS=text|json).
 class JthreadWrapper {
 public:
     template <class F>
     explicit JthreadWrapper(F&& f, std::string s)
-        : t(std::forward<F>(f), s), name(std::move(s)) {
+        : stats(async::lifecycle_stats_for(s)),
+          t(async::instrument_thread(stats, [f = std::forward<F>(f)](const std::string& n) mutable {
+                async::thread_registration registration(n);
+                f(n);
+            }), s),
+          name(std::move(s)) {
         sync_cout << "Thread " << name << " being created" << std::endl;
     }
 
     ~JthreadWrapper() {
         sync_cout << "Thread " << name << " being destroyed" << std::endl;
+        async::join_timer timing(stats);
+        t.request_stop();
+        t.join();
     }
 
 private:
+    async::lifecycle_stats* stats;   // nullptr unless enabled
     std::jthread t;
     std::string  name;
 };
@@ -62,11 +76,18 @@ void func(const std::string& name) {
 }
 
 int main() {
+    async::enable_lifecycle_stats_from_env();
+
     JthreadWrapper t1(func, "t1");
     JthreadWrapper t2(func, "t2");
     JthreadWrapper t3(func, "t3");
 
-    std::this_thread::sleep_for(2s);
+    std::this_thread::sleep_for(500ms);
+    {
+        std::osyncstream out(std::cout);
+        async::dump_threads(out);   // also visible as t1..t3 in `top -H -p <pid>`
+    }
+    std::this_thread::sleep_for(1500ms);
 
     // t1, t2, t3 will be destroyed when main exits
     sync_cout << "Main thread exiting..." << std::endl;
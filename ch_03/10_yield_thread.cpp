@@ -4,6 +4,10 @@
 #include <random>
 #include <thread>
 
+#include "include/checkpoint.hpp"
+#include "include/fast_rng.hpp"
+#include "include/watchdog.hpp"
+
 #define sync_cout std::osyncstream(std::cout)
 
 using namespace std::chrono;
@@ -14,24 +18,32 @@ namespace {
 }
 
 int main() {
+    // Reports the thread spinning in the 3s loop, and the one blocked on mtx behind it
+    async::watchdog dog({.stall_after = 1s});
 
-    auto work = [&] (const std::string& name) {
-        while (true) {
-            bool work_to_do = rand() % 2;
+    auto work = [&] (std::stop_token st, const std::string& name) {
+        auto heartbeat = dog.watch(name);
+        while (!st.stop_requested()) {
+            heartbeat.beat();
+            bool work_to_do = async::random_below(2);
             if (work_to_do) {
                 sync_cout << name << ": working\n";
                 std::lock_guard<std::mutex> lock(mtx);
-                for (auto start = steady_clock::now(), now = start; now < start + 3s; now = steady_clock::now()) { }
-            
+                // Busy for 3s, but gives up within ~100us of a stop request
+                async::checkpoint checkpoint(st);
+                for (auto start = steady_clock::now(), now = start; now < start + 3s && checkpoint(); now = steady_clock::now()) { }
             } else {
                 sync_cout << name << ": yielding\n";
                 std::this_thread::yield();
             }
         }
+        sync_cout << name << ": stopped\n";
     };
 
     std::jthread t1(work, "t1");
     std::jthread t2(work, "t2");
 
+    // The jthreads request stop and join on the way out
+    std::this_thread::sleep_for(5s);
     return 0;
 };
\ No newline at end of file
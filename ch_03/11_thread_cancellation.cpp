@@ -0,0 +1,93 @@
+#include <chrono>
+#include <iostream>
+#include <stop_token>
+#include <string>
+#include <syncstream>
+#include <thread>
+
+#include "include/cancel_scope.hpp"
+#include "include/fast_future.hpp"
+#include "include/thread_pool.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct outcome {
+    bool finished;
+    steady_clock::time_point at;
+};
+
+// A backend call that takes `cost` unless cancelled first
+outcome call(std::stop_token st, milliseconds cost) {
+    const bool finished = async::sleep_for(st, cost);
+    return {finished, steady_clock::now()};
+}
+
+void report(const std::string& request, const char* task, outcome o, const async::cancel_scope& scope,
+            steady_clock::time_point start) {
+    const auto ms = duration_cast<milliseconds>(o.at - start).count();
+    if (o.finished) {
+        sync_cout << request << "/" << task << ": finished after " << ms << "ms\n";
+    } else {
+        sync_cout << request << "/" << task << ": cancelled (" << async::to_string(scope.reason()) << ") after "
+                  << ms << "ms\n";
+    }
+}
+
+void handle_request(async::thread_pool& pool, std::string name, milliseconds budget, milliseconds disconnect_after) {
+    const auto start = steady_clock::now();
+    async::cancel_scope request(start + budget);
+    async::cancel_scope cache(async::child_of, request, start + 30ms);   // tighter deadline of its own
+    async::cancel_scope backend(async::child_of, request);               // inherits the request's deadline
+
+    auto db = async::spawn(pool, request.token(), [](std::stop_token st) { return call(st, 50ms); });
+    auto lookup = async::spawn(pool, cache.token(), [](std::stop_token st) { return call(st, 100ms); });
+    auto fetch = async::spawn(pool, backend.token(), [](std::stop_token st) { return call(st, 1000ms); });
+
+    // The client hangs up: everything under `request` stops
+    if (async::sleep_for(request.token(), disconnect_after)) request.cancel();
+
+    report(name, "db", db.get(), request, start);
+    report(name, "cache", lookup.get(), cache, start);
+    report(name, "backend", fetch.get(), backend, start);
+}
+
+} // namespace
+
+int main() {
+    async::thread_pool pool({.threads = 6});
+
+    std::jthread a(handle_request, std::ref(pool), "A", 150ms, 10s);    // runs into its deadline
+    std::jthread b(handle_request, std::ref(pool), "B", 10s, 100ms);    // client disconnects
+
+    return 0;
+}
+
+/**
+ * @brief Cancelling a tree of tasks: cancel_scope with deadlines.
+ *
+ * @details
+ * Each request owns a `cancel_scope` with a deadline. Its tasks run on a
+ * thread pool under child scopes:
+ * - `db` uses the request scope directly (50ms of work),
+ * - `cache` has its own, tighter 30ms deadline (100ms of work),
+ * - `backend` inherits the request's deadline (1s of work).
+ *
+ * Request A runs into its 150ms deadline: `db` finishes, `cache` is cut
+ * by its own deadline at 30ms, `backend` is cut at 150ms because its
+ * parent was. Request B has a long deadline but the client disconnects
+ * after 100ms: `request.cancel()` stops `backend` at once, reported as
+ * cancelled by its parent.
+ *
+ * Nothing polls: every wait takes the scope's stop_token (see
+ * cancellation.hpp), so a cancelled task returns within microseconds of
+ * the cancel instead of at the end of its sleep. Deadlines are timers in
+ * a shared timer_wheel, and a scope cancelled early frees its timer.
+ *
+ * Compare 09_move_threads.cpp, whose thread can only be waited for, and
+ * 07_daemon_threads.cpp, whose one stop_token reaches exactly one thread.
+ */
@@ -0,0 +1,93 @@
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <syncstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "include/int_format.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Batch integer formatting benchmark.
+ *
+ * @details
+ * Compares three ways of turning a std::vector<int> into text:
+ * 1. `std::ostringstream << num << " "` per element (what streaming each
+ *    int through sync_cout boils down to, minus the per-element lock).
+ * 2. `std::to_chars` per element into one preallocated buffer.
+ * 3. `async::format_ints()` (digit-pair table, single buffer) and
+ *    `async::format_ints_parallel()` (same, split across threads).
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 12_int_format.cpp -o exec/12_int_format
+ */
+
+using namespace std::chrono;
+
+namespace {
+    std::size_t sink = 0;   // keeps the optimizer from dropping the work
+}
+
+template <typename F>
+void bench(const std::string& label, std::size_t n, int reps, F&& f) {
+    auto start = steady_clock::now();
+    for (int r = 0; r < reps; ++r) {
+        sink += f().size();
+    }
+    double secs = duration<double>(steady_clock::now() - start).count();
+    double rate = static_cast<double>(n) * reps / secs;
+    sync_cout << label << ": " << rate / 1e6 << " M ints/sec\n";
+}
+
+int main() {
+    constexpr std::size_t n = 1 << 22;
+    constexpr int reps = 5;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(std::numeric_limits<int>::min(),
+                                            std::numeric_limits<int>::max());
+    std::vector<int> vec(n);
+    for (auto& v : vec) v = dist(gen);
+
+    // Sanity check: all three methods must produce identical text
+    std::ostringstream check;
+    for (int num : vec) check << num << " ";
+    if (check.str() != async::format_ints(vec) || check.str() != async::format_ints_parallel(vec)) {
+        sync_cout << "format mismatch!\n";
+        return 1;
+    }
+
+    sync_cout << n << " random ints, " << std::thread::hardware_concurrency() << " hardware threads\n";
+
+    bench("ostringstream       ", n, reps, [&] {
+        std::ostringstream os;
+        for (int num : vec) os << num << " ";
+        return os.str();
+    });
+
+    bench("std::to_chars       ", n, reps, [&] {
+        std::string out(n * 12, '\0');
+        char* p = out.data();
+        for (int num : vec) {
+            p = std::to_chars(p, out.data() + out.size(), num).ptr;
+            *p++ = ' ';
+        }
+        out.resize(p - out.data());
+        return out;
+    });
+
+    bench("format_ints         ", n, reps, [&] { return async::format_ints(vec); });
+    bench("format_ints_parallel", n, reps, [&] { return async::format_ints_parallel(vec); });
+
+    // Small values (1-3 digits) are the common case for debug dumps
+    for (auto& v : vec) v = static_cast<int>(gen() % 1000);
+    bench("format_ints (small) ", n, reps, [&] { return async::format_ints(vec); });
+
+    sync_cout << "(sink " << sink << ")\n";
+    return 0;
+}
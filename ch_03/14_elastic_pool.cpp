@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/thread_pool.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Fixed vs. elastic pool under a bursty, partly blocking load.
+ *
+ * @details
+ * Tasks in 06_return_vals.cpp spend their time in `sleep_for`, which ties
+ * up a worker without using its core. This benchmark submits bursts of
+ * tasks that each "block" for 2ms (inside an `async::blocking_section`)
+ * and then compute for 20us, separated by idle gaps.
+ *
+ * For each pool we report:
+ * - wall time for all bursts (throughput),
+ * - p50/p99 latency from submit() to task completion,
+ * - average and peak number of worker threads (sampled every 500us).
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 14_elastic_pool.cpp -o exec/14_elastic_pool
+ */
+
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int bursts = 10;
+constexpr int tasks_per_burst = 200;
+constexpr auto gap = 50ms;
+
+void spin_for(nanoseconds d) {
+    for (auto start = steady_clock::now(), now = start; now < start + d; now = steady_clock::now()) { }
+}
+
+double percentile(std::vector<double> v, double p) {
+    std::sort(v.begin(), v.end());
+    return v[static_cast<std::size_t>(p * (v.size() - 1))];
+}
+
+void run(const std::string& label, async::thread_pool_options opts) {
+    std::vector<double> latency(bursts * tasks_per_burst);
+    std::atomic<bool> sampling{true};
+    double thread_sum = 0;
+    long samples = 0;
+    std::size_t peak = 0;
+
+    auto start = steady_clock::now();
+    {
+        async::thread_pool pool(opts);
+
+        std::jthread sampler([&] {
+            while (sampling.load(std::memory_order_relaxed)) {
+                thread_sum += static_cast<double>(pool.thread_count());
+                ++samples;
+                std::this_thread::sleep_for(500us);
+            }
+        });
+
+        for (int b = 0; b < bursts; ++b) {
+            for (int i = 0; i < tasks_per_burst; ++i) {
+                auto submitted = steady_clock::now();
+                pool.submit([&latency, idx = b * tasks_per_burst + i, submitted] {
+                    {
+                        async::blocking_section blocking;
+                        std::this_thread::sleep_for(2ms);
+                    }
+                    spin_for(20us);
+                    latency[idx] = duration<double, std::milli>(steady_clock::now() - submitted).count();
+                });
+            }
+            std::this_thread::sleep_for(gap);
+        }
+        pool.wait_idle();
+
+        sampling = false;
+        sampler.join();
+        peak = pool.stats().peak_threads;
+    }
+    double wall = duration<double>(steady_clock::now() - start).count();
+
+    sync_cout << label
+              << "  wall: " << wall << "s"
+              << "  p50: " << percentile(latency, 0.50) << "ms"
+              << "  p99: " << percentile(latency, 0.99) << "ms"
+              << "  avg threads: " << thread_sum / static_cast<double>(std::max(1L, samples))
+              << "  peak: " << peak << "\n";
+}
+
+} // namespace
+
+int main() {
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+    async::thread_pool_options fixed;
+    fixed.threads = cores;
+
+    async::thread_pool_options big = fixed;
+    big.threads = 64;
+
+    async::thread_pool_options elastic = fixed;
+    elastic.max_threads = 64;
+    elastic.keep_alive = 20ms;
+
+    async::thread_pool_options damped = elastic;
+    damped.spawn_queue_depth = 8;
+    damped.spawn_cooldown = 200us;
+
+    sync_cout << bursts << " bursts of " << tasks_per_burst << " tasks (2ms blocking + 20us compute), "
+              << cores << " cores\n";
+
+    run("fixed(" + std::to_string(cores) + ")          ", fixed);
+    run("fixed(64)         ", big);
+    run("elastic(" + std::to_string(cores) + "..64)    ", elastic);
+    run("elastic damped    ", damped);
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/thread_pool.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Per-task overhead of submit() vs. submit_bulk() / submit_n().
+ *
+ * @details
+ * 01_thread_creation.cpp constructs every std::thread individually. A pool
+ * removes the thread creation cost, but a one-at-a-time submit() still
+ * pays one lock round trip and a possible wakeup per task.
+ *
+ * Here 64k trivial tasks (one relaxed increment each) are submitted in
+ * batches of 1, 16, 256 and 4096, and the time from the first submit to
+ * wait_idle() returning is divided by the number of tasks.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 15_bulk_submit.cpp -o exec/15_bulk_submit
+ */
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr std::size_t total_tasks = 1 << 16;
+
+std::atomic<std::size_t> counter{0};
+
+template <typename Submit>
+double ns_per_task(async::thread_pool& pool, std::size_t batch, Submit&& submit) {
+    counter = 0;
+    auto start = steady_clock::now();
+    for (std::size_t done = 0; done < total_tasks; done += batch) {
+        submit(batch);
+    }
+    pool.wait_idle();
+    auto ns = duration<double, std::nano>(steady_clock::now() - start).count();
+    if (counter.load() != total_tasks) sync_cout << "lost tasks!\n";
+    return ns / total_tasks;
+}
+
+} // namespace
+
+int main() {
+    async::thread_pool pool;
+    auto work = [] { counter.fetch_add(1, std::memory_order_relaxed); };
+
+    sync_cout << "pool threads: " << pool.thread_count() << ", " << total_tasks << " tasks\n";
+    sync_cout << "batch    submit()    submit_bulk()    submit_n()   (ns/task)\n";
+
+    for (std::size_t batch : {1, 16, 256, 4096}) {
+        std::vector<std::function<void()>> tasks(batch, work);
+
+        double single = ns_per_task(pool, batch, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) pool.submit(work);
+        });
+        double bulk = ns_per_task(pool, batch, [&](std::size_t) {
+            pool.submit_bulk(tasks.begin(), tasks.end());
+        });
+        double n_copies = ns_per_task(pool, batch, [&](std::size_t n) {
+            pool.submit_n(n, work);
+        });
+
+        sync_cout << batch << "\t " << single << "\t     " << bulk << "\t      " << n_copies << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <syncstream>
+#include <thread>
+
+#include "include/fast_future.hpp"
+#include "include/thread_pool.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Round-trip latency and allocations: std::future vs. fast_future.
+ *
+ * @details
+ * Replaces the `std::ref(result)` write-through of 06_return_vals.cpp
+ * with a future and measures one round trip (create promise, hand the
+ * task to another thread, set the value, get() it back):
+ *
+ * - std::async:             new thread per call, heap shared state
+ * - std::promise + pool:    pooled thread, heap state with mutex + condvar
+ * - fast_promise + pool:    pooled thread, one heap state, atomic word
+ * - fast_promise (inline):  pooled thread, state on the caller's stack
+ *
+ * Allocations are counted by replacing the global operator new; the pool
+ * task itself accounts for one allocation in every pooled variant.
+ *
+ * Finally it checks error propagation: an exception from the task, and a
+ * promise whose value constructor throws, which must still report
+ * broken_promise when dropped.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 16_fast_future.cpp -o exec/16_fast_future
+ */
+
+using namespace std::chrono;
+
+namespace {
+    std::atomic<std::size_t> allocations{0};
+}
+
+void* operator new(std::size_t n) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+// GCC flags free() on memory from the replaced operator new as mismatched
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+template <typename F>
+void bench(const std::string& label, int iterations, F&& round_trip) {
+    allocations = 0;
+    auto start = steady_clock::now();
+    long long sum = 0;
+    for (int i = 0; i < iterations; ++i) sum += round_trip(i);
+    double ns = duration<double, std::nano>(steady_clock::now() - start).count() / iterations;
+    double allocs = static_cast<double>(allocations.load()) / iterations;
+    sync_cout << label << ns / 1000 << " us/round trip, " << allocs << " allocs/round trip"
+              << " (sum " << sum << ")\n";
+}
+
+} // namespace
+
+int main() {
+    constexpr int iterations = 20000;
+    async::thread_pool pool({.threads = 1});
+
+    bench("std::async             ", iterations / 10, [](int i) {
+        return std::async(std::launch::async, [i] { return i; }).get();
+    });
+
+    bench("std::promise + pool    ", iterations, [&](int i) {
+        std::promise<int> p;
+        auto f = p.get_future();
+        pool.submit([p = std::move(p), i] () mutable { p.set_value(i); });
+        return f.get();
+    });
+
+    bench("fast_promise + pool    ", iterations, [&](int i) {
+        return async::spawn(pool, [i] { return i; }).get();
+    });
+
+    bench("fast_promise (inline)  ", iterations, [&](int i) {
+        async::future_state<int> state;
+        async::fast_promise<int> p(state);
+        auto f = p.get_future();
+        pool.submit([p = std::move(p), i] () mutable { p.set_value(i); });
+        return f.get();
+    });
+
+    // Exceptions propagate through get()
+    try {
+        async::spawn(pool, [] () -> int { throw std::runtime_error("boom"); }).get();
+    } catch (const std::exception& e) {
+        sync_cout << "exception propagated: " << e.what() << "\n";
+    }
+
+    // A value whose constructor throws leaves the promise unsatisfied: it breaks when dropped
+    struct throws_on_construct {
+        explicit throws_on_construct(int) { throw std::runtime_error("ctor"); }
+    };
+    {
+        async::fast_future<throws_on_construct> f;
+        {
+            async::fast_promise<throws_on_construct> p;
+            f = p.get_future();
+            try {
+                p.set_value(1);
+            } catch (const std::runtime_error&) {}
+        }
+        try {
+            f.get();
+            sync_cout << "throwing constructor: no error!\n";
+        } catch (const std::future_error& e) {
+            if (e.code() != std::future_errc::broken_promise) sync_cout << "throwing constructor: wrong error!\n";
+            sync_cout << "throwing constructor: " << e.what() << "\n";
+        }
+    }
+
+    return 0;
+}
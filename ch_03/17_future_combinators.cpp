@@ -0,0 +1,117 @@
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/fast_future.hpp"
+#include "include/future_combinators.hpp"
+#include "include/thread_pool.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief then / when_all / when_any, and a 10k fan-out/fan-in benchmark.
+ *
+ * @details
+ * Fan-out: submit 10'000 small tasks to the pool.
+ * Fan-in:
+ * - std::future + join loop: one std::promise per task, then the caller
+ *   blocks in f.get() 10'000 times.
+ * - when_all: one continuation per future decrements a shared counter;
+ *   the caller blocks once on the combined future.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 17_future_combinators.cpp -o exec/17_future_combinators
+ */
+
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int fan_out = 10000;
+
+long long work(int i) {
+    unsigned long long acc = static_cast<unsigned>(i);
+    for (unsigned k = 0; k < 200; ++k) acc = acc * 31 + k;
+    return static_cast<long long>(acc & 0xffff);
+}
+
+template <typename F>
+void bench(const std::string& label, int reps, F&& round) {
+    long long sum = 0;
+    auto start = steady_clock::now();
+    for (int r = 0; r < reps; ++r) sum += round();
+    double ms = duration<double, std::milli>(steady_clock::now() - start).count() / reps;
+    sync_cout << label << ms << " ms per " << fan_out << " futures (sum " << sum << ")\n";
+}
+
+} // namespace
+
+int main() {
+    async::thread_pool pool;
+
+    // then: continuations run inline or on the pool, exceptions skip them
+    auto len = async::spawn(pool, [] { return std::string("continuation"); })
+                   .then([](std::string s) { return s.size(); })
+                   .then(pool, [](std::size_t n) { return n * 2; });
+    sync_cout << "then chain: " << len.get() << "\n";
+
+    auto failed = async::spawn(pool, [] () -> int { throw std::runtime_error("source failed"); })
+                      .then([](int v) { return v + 1; });
+    try {
+        failed.get();
+    } catch (const std::exception& e) {
+        sync_cout << "then propagated: " << e.what() << "\n";
+    }
+
+    // Heterogeneous when_all / when_any
+    auto [i, s, v] = async::when_all(async::spawn(pool, [] { return 7; }),
+                                     async::spawn(pool, [] { return std::string("seven"); }),
+                                     async::spawn(pool, [] {})).get();
+    (void)v;
+    sync_cout << "when_all: " << i << ", " << s << "\n";
+
+    auto any = async::when_any(async::spawn(pool, [] { std::this_thread::sleep_for(50ms); return 1; }),
+                               async::spawn(pool, [] { return std::string("fast"); })).get();
+    sync_cout << "when_any: index " << any.index << "\n";
+
+    // Fan-out / fan-in
+    constexpr int reps = 10;
+
+    bench("std::future + join loop  ", reps, [&] {
+        std::vector<std::future<long long>> futures;
+        futures.reserve(fan_out);
+        for (int k = 0; k < fan_out; ++k) {
+            std::promise<long long> p;
+            futures.push_back(p.get_future());
+            pool.submit([p = std::move(p), k] () mutable { p.set_value(work(k)); });
+        }
+        long long sum = 0;
+        for (auto& f : futures) sum += f.get();
+        return sum;
+    });
+
+    bench("fast_future + join loop  ", reps, [&] {
+        std::vector<async::fast_future<long long>> futures;
+        futures.reserve(fan_out);
+        for (int k = 0; k < fan_out; ++k) futures.push_back(async::spawn(pool, [k] { return work(k); }));
+        long long sum = 0;
+        for (auto& f : futures) sum += f.get();
+        return sum;
+    });
+
+    bench("fast_future + when_all   ", reps, [&] {
+        std::vector<async::fast_future<long long>> futures;
+        futures.reserve(fan_out);
+        for (int k = 0; k < fan_out; ++k) futures.push_back(async::spawn(pool, [k] { return work(k); }));
+        auto all = async::when_all(std::move(futures)).get();
+        return std::accumulate(all.begin(), all.end(), 0LL);
+    });
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/result_array.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief False sharing: packed vs. cache-line-padded result slots.
+ *
+ * @details
+ * N writers (2..64) each update only their own slot of a result_array
+ * `writes_per_thread` times. With the packed layout eight uint64_t slots
+ * share a cache line, so the line bounces between cores on every store;
+ * the padded layout gives each writer a private line.
+ *
+ * The stores go through std::atomic_ref with relaxed ordering so the
+ * compiler cannot keep the running value in a register.
+ *
+ * On a machine with fewer cores than writers the threads time-slice and
+ * the gap between the layouts shrinks.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 18_false_sharing.cpp -o exec/18_false_sharing
+ */
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr std::uint64_t writes_per_thread = 2'000'000;
+
+template <bool Padded>
+double run(unsigned writers) {
+    async::result_array<std::uint64_t, Padded> results(writers);
+
+    auto start = steady_clock::now();
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned w = 0; w < writers; ++w) {
+            threads.emplace_back([&results, w] {
+                std::atomic_ref<std::uint64_t> slot(results[w]);
+                for (std::uint64_t k = 0; k < writes_per_thread; ++k) {
+                    slot.store(slot.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                }
+                results.complete(w);
+            });
+        }
+    }
+    double secs = duration<double>(steady_clock::now() - start).count();
+
+    std::uint64_t total = 0;
+    for (auto v : results.gather()) total += v;
+    if (total != writes_per_thread * writers) sync_cout << "lost writes!\n";
+
+    return static_cast<double>(total) / secs / 1e6;
+}
+
+} // namespace
+
+int main() {
+    sync_cout << "hardware threads: " << std::thread::hardware_concurrency()
+              << ", slot size packed/padded: " << sizeof(std::uint64_t) << "/" << async::cache_line_size << " bytes\n";
+    sync_cout << "writers   packed (M writes/s)   padded (M writes/s)\n";
+
+    for (unsigned writers = 2; writers <= 64; writers *= 2) {
+        double packed = run<false>(writers);
+        double padded = run<true>(writers);
+        sync_cout << writers << "\t  " << packed << "\t\t\t" << padded << "\n";
+    }
+
+    return 0;
+}
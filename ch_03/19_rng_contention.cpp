@@ -0,0 +1,109 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/fast_rng.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief rand() vs. per-thread generators at 1..64 threads.
+ *
+ * @details
+ * Every thread draws `draws_per_thread` numbers in [0, 10) (the same
+ * range func() in 06_return_vals.cpp uses) and sums them. Reported is the
+ * aggregate rate in millions of draws per second:
+ *
+ * - rand() % 10:          glibc global state behind a lock
+ * - mt19937 (tls) + dist: thread_local std::mt19937 and uniform_int_distribution
+ * - xoshiro256** bounded: async::random_below (Lemire)
+ * - pcg32 bounded:        local async::pcg32 + async::bounded
+ * - fill (8 lanes):       async::fill of raw 64-bit values, 4k at a time
+ *
+ * Build:  g++ -std=c++20 -O2 -march=native -pthread 19_rng_contention.cpp -o exec/19_rng_contention
+ */
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr std::size_t draws_per_thread = 1 << 21;
+
+std::atomic<std::uint64_t> sink{0};   // keeps the sums alive
+
+template <typename F>
+double run(unsigned threads, F&& draw_all) {
+    std::vector<std::uint64_t> sums(threads);
+    auto start = steady_clock::now();
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                async::seed_thread_rng(t);
+                sums[t] = draw_all(t);
+            });
+        }
+    }
+    double secs = duration<double>(steady_clock::now() - start).count();
+    std::uint64_t total = 0;
+    for (auto s : sums) total += s;
+    sink += total;
+    return static_cast<double>(draws_per_thread) * threads / secs / 1e6;
+}
+
+} // namespace
+
+int main() {
+    sync_cout << "threads  rand()   mt19937   xoshiro   pcg32   fill     (M draws/s)\n";
+
+    for (unsigned threads = 1; threads <= 64; threads *= 2) {
+        double r_rand = run(threads, [](unsigned) {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < draws_per_thread; ++i) sum += static_cast<unsigned>(rand() % 10);
+            return sum;
+        });
+
+        double r_mt = run(threads, [](unsigned t) {
+            thread_local std::mt19937 gen(t);
+            std::uniform_int_distribution<unsigned> dist(0, 9);
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < draws_per_thread; ++i) sum += dist(gen);
+            return sum;
+        });
+
+        double r_xo = run(threads, [](unsigned) {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < draws_per_thread; ++i) sum += async::random_below(10);
+            return sum;
+        });
+
+        double r_pcg = run(threads, [](unsigned t) {
+            async::pcg32 gen(42, t);
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < draws_per_thread; ++i) sum += async::bounded(gen, 10);
+            return sum;
+        });
+
+        double r_fill = run(threads, [](unsigned) {
+            std::vector<std::uint64_t> buf(4096);
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < draws_per_thread; i += buf.size()) {
+                async::fill(buf);
+                sum += buf[0];
+            }
+            return sum;
+        });
+
+        sync_cout << threads << "\t " << r_rand << "\t  " << r_mt << "\t    " << r_xo
+                  << "\t      " << r_pcg << "\t" << r_fill << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/channel.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Channel throughput for SPSC, MPSC, SPMC and MPMC at several capacities.
+ *
+ * @details
+ * Producers push `items` integers in total through one async::channel and
+ * close it once all of them are done; consumers drain with recv_batch()
+ * until the channel is closed and empty. The checksum verifies that every
+ * item arrived exactly once.
+ *
+ * Then `close()` races against senders that keep sending until a send
+ * fails: every send that returned true must be received.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 20_channel.cpp -o exec/20_channel
+ */
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr std::uint64_t items = 1 << 20;
+
+double run(unsigned producers, unsigned consumers, std::size_t capacity) {
+    async::channel<std::uint64_t> ch(capacity);
+    std::atomic<unsigned> producers_left{producers};
+    std::atomic<std::uint64_t> checksum{0};
+
+    auto start = steady_clock::now();
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned c = 0; c < consumers; ++c) {
+            threads.emplace_back([&] {
+                std::uint64_t batch[64];
+                std::uint64_t sum = 0;
+                while (std::size_t n = ch.recv_batch(batch, 64)) {
+                    for (std::size_t i = 0; i < n; ++i) sum += batch[i];
+                }
+                checksum.fetch_add(sum);
+            });
+        }
+        for (unsigned p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                for (std::uint64_t i = p; i < items; i += producers) ch.send(i);
+                if (producers_left.fetch_sub(1) == 1) ch.close();
+            });
+        }
+    }
+    double secs = duration<double>(steady_clock::now() - start).count();
+
+    if (checksum.load() != items * (items - 1) / 2) sync_cout << "checksum mismatch!\n";
+    return static_cast<double>(items) / secs / 1e6;
+}
+
+// Senders send until close() makes them fail; counts accepted vs. received values
+bool close_race(unsigned round) {
+    async::channel<std::uint64_t> ch(64);
+    std::atomic<std::uint64_t> accepted{0}, received{0};
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned c = 0; c < 2; ++c) {
+            threads.emplace_back([&] {
+                std::uint64_t n = 0;
+                while (ch.recv()) ++n;
+                received.fetch_add(n);
+            });
+        }
+        for (unsigned p = 0; p < 4; ++p) {
+            threads.emplace_back([&] {
+                std::uint64_t n = 0;
+                while (ch.send(n)) ++n;
+                accepted.fetch_add(n);
+            });
+        }
+        std::this_thread::sleep_for(microseconds(round % 200));
+        ch.close();
+    }
+    return accepted.load() == received.load();
+}
+
+} // namespace
+
+int main() {
+    struct shape {
+        const char* name;
+        unsigned producers;
+        unsigned consumers;
+    };
+    const shape shapes[] = {{"SPSC", 1, 1}, {"MPSC", 4, 1}, {"SPMC", 1, 4}, {"MPMC", 4, 4}};
+
+    sync_cout << items << " items, " << std::thread::hardware_concurrency() << " hardware threads (M items/s)\n";
+    sync_cout << "shape   cap=64   cap=1024   cap=16384\n";
+
+    for (const auto& s : shapes) {
+        sync_cout << s.name << "\t"
+                  << run(s.producers, s.consumers, 64) << "\t "
+                  << run(s.producers, s.consumers, 1024) << "\t    "
+                  << run(s.producers, s.consumers, 16384) << "\n";
+    }
+
+    constexpr unsigned rounds = 1000;
+    unsigned lost = 0;
+    for (unsigned r = 0; r < rounds; ++r) lost += !close_race(r);
+    sync_cout << "close vs. concurrent sends: " << rounds << " rounds, " << lost << " with lost values\n";
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/channel.hpp"
+#include "include/spsc_ring.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief SPSC ring throughput and ping-pong latency.
+ *
+ * @details
+ * Throughput: one producer pushes `items` integers, one consumer pops
+ * them, using single-element and batch (64) operations; the MPMC channel
+ * is run on the same workload for reference.
+ *
+ * Latency: two rings form a loop; thread A pushes a token, thread B pops
+ * it and pushes it back. Half the round trip is the one-way hand-off
+ * latency. Both sides busy-poll, so this only makes sense with at least
+ * two cores; on one core it measures scheduler time slices.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 21_spsc_ring.cpp -o exec/21_spsc_ring
+ */
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr std::uint64_t items = 1 << 24;
+constexpr std::size_t capacity = 4096;
+
+template <typename Producer, typename Consumer>
+double throughput(Producer&& produce, Consumer&& consume) {
+    auto start = steady_clock::now();
+    std::uint64_t sum = 0;
+    {
+        std::jthread producer(produce);
+        sum = consume();
+    }
+    double secs = duration<double>(steady_clock::now() - start).count();
+    if (sum != items * (items - 1) / 2) sync_cout << "checksum mismatch!\n";
+    return static_cast<double>(items) / secs / 1e6;
+}
+
+// Queried once: hardware_concurrency() is a syscall and relax() runs inside the timed loops
+const bool single_core = std::thread::hardware_concurrency() < 2;
+
+void relax() {
+    if (single_core) std::this_thread::yield();
+}
+
+} // namespace
+
+int main() {
+    {
+        async::spsc_ring<std::uint64_t> ring(capacity);
+        double single = throughput(
+            [&] { for (std::uint64_t i = 0; i < items; ++i) while (!ring.try_push(i)) relax(); },
+            [&] {
+                std::uint64_t sum = 0;
+                for (std::uint64_t n = 0; n < items;) {
+                    if (auto v = ring.try_pop()) { sum += *v; ++n; } else { relax(); }
+                }
+                return sum;
+            });
+        sync_cout << "spsc_ring single:   " << single << " M ops/s\n";
+    }
+
+    {
+        async::spsc_ring<std::uint64_t> ring(capacity);
+        double batched = throughput(
+            [&] {
+                std::uint64_t buf[64];
+                for (std::uint64_t i = 0; i < items;) {
+                    const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(64, items - i));
+                    for (std::size_t k = 0; k < n; ++k) buf[k] = i + k;
+                    std::size_t pushed = ring.push_batch(buf, n);
+                    if (pushed == 0) relax();
+                    i += pushed;   // a partial push resends the rest next round
+                }
+            },
+            [&] {
+                std::uint64_t buf[64];
+                std::uint64_t sum = 0;
+                for (std::uint64_t n = 0; n < items;) {
+                    std::size_t got = ring.pop_batch(buf, 64);
+                    if (got == 0) relax();
+                    for (std::size_t k = 0; k < got; ++k) sum += buf[k];
+                    n += got;
+                }
+                return sum;
+            });
+        sync_cout << "spsc_ring batch 64: " << batched << " M ops/s\n";
+    }
+
+    {
+        async::channel<std::uint64_t> ch(capacity);
+        double mpmc = throughput(
+            [&] { for (std::uint64_t i = 0; i < items; ++i) ch.send(i); },
+            [&] {
+                std::uint64_t sum = 0;
+                for (std::uint64_t n = 0; n < items; ++n) sum += *ch.recv();
+                return sum;
+            });
+        sync_cout << "channel (MPMC):     " << mpmc << " M ops/s\n";
+    }
+
+    // Ping-pong latency
+    constexpr int round_trips = 100000;
+    async::spsc_ring<int> ping(2), pong(2);
+    std::vector<double> samples(round_trips);
+    {
+        std::jthread echo([&] {
+            for (int i = 0; i < round_trips; ++i) {
+                std::optional<int> v;
+                while (!(v = ping.try_pop())) relax();
+                while (!pong.try_push(*v)) relax();
+            }
+        });
+        for (int i = 0; i < round_trips; ++i) {
+            auto start = steady_clock::now();
+            while (!ping.try_push(i)) relax();
+            while (!pong.try_pop()) relax();
+            samples[i] = duration<double, std::nano>(steady_clock::now() - start).count();
+        }
+    }
+    std::sort(samples.begin(), samples.end());
+    sync_cout << "ping-pong round trip: p50 " << samples[round_trips / 2] << "ns"
+              << "  p99 " << samples[round_trips * 99 / 100] << "ns\n";
+
+    return 0;
+}
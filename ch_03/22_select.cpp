@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/channel.hpp"
+#include "include/select.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief select() over a data channel, a control channel, a stop_token and a ticker.
+ *
+ * @details
+ * 1. A consumer jthread multiplexes a data channel, a control channel,
+ *    its stop_token and a 20ms tick deadline with one select() call per
+ *    event, and exits when main() requests stop.
+ * 2. Fast-path cost: with data already buffered, a select() over
+ *    {stop, data, deadline} is compared against a bare try_recv().
+ * 3. Wake-up latency: the consumer is parked in select() when a producer
+ *    sends a timestamp.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 22_select.cpp -o exec/22_select
+ */
+
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+int main() {
+    // 1. Demo
+    {
+        async::channel<int> data(64);
+        async::channel<std::string> control(8);
+
+        std::jthread consumer([&](std::stop_token token) {
+            int received = 0, ticks = 0;
+            auto next_tick = steady_clock::now() + 20ms;
+            bool running = true;
+            while (running) {
+                async::select(
+                    async::on_stop(token, [&] { running = false; }),
+                    async::on_recv(control, [&](std::optional<std::string> cmd) {
+                        if (cmd) sync_cout << "consumer: control \"" << *cmd << "\"\n";
+                    }),
+                    async::on_recv(data, [&](std::optional<int> v) { if (v) ++received; }),
+                    async::on_deadline(next_tick, [&] { ++ticks; next_tick += 20ms; }));
+            }
+            sync_cout << "consumer: stopped after " << received << " values and " << ticks << " ticks\n";
+        });
+
+        for (int i = 0; i < 100; ++i) {
+            data.send(i);
+            if (i % 25 == 0) control.send("checkpoint " + std::to_string(i));
+            std::this_thread::sleep_for(1ms);
+        }
+        consumer.request_stop();
+    }
+
+    // 2. Fast path
+    {
+        constexpr int n = 1 << 20;
+        async::channel<int> data(n);
+        std::stop_source never;
+        const auto far = steady_clock::now() + 1h;
+        long long sum = 0;
+
+        for (int i = 0; i < n; ++i) data.try_send(i);
+        auto start = steady_clock::now();
+        for (int i = 0; i < n; ++i) sum += *data.try_recv();
+        double bare = duration<double, std::nano>(steady_clock::now() - start).count() / n;
+
+        for (int i = 0; i < n; ++i) data.try_send(i);
+        start = steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            async::select(async::on_stop(never.get_token(), [] {}),
+                          async::on_recv(data, [&](std::optional<int> v) { sum += *v; }),
+                          async::on_deadline(far, [] {}));
+        }
+        double selected = duration<double, std::nano>(steady_clock::now() - start).count() / n;
+
+        sync_cout << "ready case: try_recv " << bare << "ns, select " << selected << "ns (sum " << sum << ")\n";
+    }
+
+    // 3. Wake-up latency
+    {
+        constexpr int rounds = 2000;
+        async::channel<steady_clock::time_point> data(4);
+        std::vector<double> latency;
+        latency.reserve(rounds);
+
+        std::jthread consumer([&](std::stop_token token) {
+            bool running = true;
+            while (running) {
+                async::select(async::on_stop(token, [&] { running = false; }),
+                              async::on_recv(data, [&](std::optional<steady_clock::time_point> sent) {
+                                  if (sent) latency.push_back(duration<double, std::micro>(steady_clock::now() - *sent).count());
+                              }));
+            }
+        });
+
+        for (int i = 0; i < rounds; ++i) {
+            std::this_thread::sleep_for(200us);   // let the consumer park
+            data.send(steady_clock::now());
+        }
+        while (!data.empty()) std::this_thread::yield();
+        consumer.request_stop();
+        consumer.join();
+
+        std::sort(latency.begin(), latency.end());
+        sync_cout << "wake-up latency: p50 " << latency[latency.size() / 2] << "us"
+                  << "  p99 " << latency[latency.size() * 99 / 100] << "us\n";
+    }
+
+    return 0;
+}
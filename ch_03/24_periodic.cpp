@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/periodic.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Drift, missed-tick policies and many jobs on one scheduler thread.
+ *
+ * @details
+ * 1. Drift: a 10ms job doing 3ms of work, 100 runs. The sleep_for loop
+ *    from 07_daemon_threads.cpp ends ~300ms late; fixed_delay behaves the
+ *    same by design; fixed_rate stays on the steady_clock grid.
+ * 2. Missed ticks: a 10ms job where every 10th run takes 35ms, for one
+ *    second under skip, catch_up and coalesce.
+ * 3. Scale: 1000 jobs at 50ms periods on a single driver thread.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 24_periodic.cpp -o exec/24_periodic
+ */
+
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto period = 10ms;
+constexpr auto work = 3ms;
+constexpr int runs = 100;
+
+void busy_for(steady_clock::duration d) {
+    const auto until = steady_clock::now() + d;
+    while (steady_clock::now() < until) {}
+}
+
+double drift_ms(steady_clock::time_point start, steady_clock::time_point last) {
+    // The last run should start at start + runs * period
+    return duration<double, std::milli>(last - (start + period * runs)).count();
+}
+
+void drift(async::periodic_scheduler& scheduler, const char* label, async::periodic_mode mode) {
+    std::atomic<int> count{0};
+    steady_clock::time_point last;
+    const auto start = steady_clock::now();
+    auto handle = scheduler.schedule_every(period, [&] {
+        if (count.load() == runs) return;
+        const auto started = steady_clock::now();
+        busy_for(work);
+        if (count.load() + 1 == runs) last = started;
+        count.fetch_add(1);   // publishes `last`
+    }, {mode});
+    while (count.load() < runs) std::this_thread::sleep_for(5ms);
+    handle.cancel();
+    sync_cout << label << drift_ms(start, last) << "ms\n";
+}
+
+const char* name(async::missed_tick_policy p) {
+    switch (p) {
+        case async::missed_tick_policy::skip: return "skip    ";
+        case async::missed_tick_policy::catch_up: return "catch_up";
+        case async::missed_tick_policy::coalesce: return "coalesce";
+    }
+    return "";
+}
+
+} // namespace
+
+int main() {
+    async::periodic_scheduler scheduler;
+
+    // 1. Drift
+    {
+        const auto start = steady_clock::now();
+        steady_clock::time_point last;
+        for (int i = 0; i < runs; ++i) {
+            std::this_thread::sleep_for(period);
+            last = steady_clock::now();
+            busy_for(work);
+        }
+        sync_cout << "sleep_for loop:  " << drift_ms(start, last) << "ms\n";
+    }
+    drift(scheduler, "fixed_delay:     ", async::periodic_mode::fixed_delay);
+    drift(scheduler, "fixed_rate:      ", async::periodic_mode::fixed_rate);
+
+    // 2. Missed-tick policies
+    for (auto policy : {async::missed_tick_policy::skip, async::missed_tick_policy::catch_up,
+                        async::missed_tick_policy::coalesce}) {
+        auto handle = scheduler.schedule_every(period, [](const async::periodic_tick& t) {
+            if (t.index % 10 == 9) std::this_thread::sleep_for(35ms);
+        }, {async::periodic_mode::fixed_rate, policy});
+        std::this_thread::sleep_for(1s);
+        handle.cancel();
+        sync_cout << name(policy) << ": " << handle.runs() << " runs, " << handle.missed() << " slots missed\n";
+    }
+
+    // 3. Many jobs, one thread
+    {
+        constexpr int jobs = 1000;
+        std::vector<double> late_us;
+        std::mutex late_mtx;
+        async::periodic_scheduler shared;   // destroyed first: waits for runs in progress
+        std::vector<async::periodic_handle> handles;
+        for (int i = 0; i < jobs; ++i) {
+            handles.push_back(shared.schedule_every(50ms, [&](const async::periodic_tick& t) {
+                const double late = duration<double, std::micro>(steady_clock::now() - t.scheduled).count();
+                std::lock_guard<std::mutex> lock(late_mtx);
+                late_us.push_back(late);
+            }));
+        }
+        std::this_thread::sleep_for(1s);
+        for (auto& h : handles) h.cancel();
+
+        std::lock_guard<std::mutex> lock(late_mtx);
+        std::sort(late_us.begin(), late_us.end());
+        sync_cout << jobs << " jobs x 50ms on one thread: " << late_us.size() << " runs, lateness p50 "
+                  << late_us[late_us.size() / 2] << "us  p99 " << late_us[late_us.size() * 99 / 100] << "us\n";
+    }
+
+    return 0;
+}
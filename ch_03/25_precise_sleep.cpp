@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/precise_sleep.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Wake-up jitter histogram: sleep_until vs. precise_sleep_until.
+ *
+ * @details
+ * For 50us, 200us and 1ms targets each method sleeps `samples` times to an
+ * absolute deadline and records how late it woke up:
+ * - sleep_until:            default timer slack (50us)
+ * - sleep_until, slack 1ns: same call after `set_timer_slack(1ns)`
+ * - precise_sleep_until:    clock_nanosleep + learned spin margin
+ * Each method runs on a fresh thread, since timer slack is per thread.
+ * Reported: a lateness histogram, p50/p99, and the CPU time spent per
+ * sleep (CLOCK_THREAD_CPUTIME_ID), which is the price of the spin.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 25_precise_sleep.cpp -o exec/25_precise_sleep
+ */
+
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int samples = 2000;
+constexpr std::array<double, 9> bucket_us{1, 2, 5, 10, 20, 50, 100, 200, 500};
+
+double thread_cpu_us() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) * 1e6 + static_cast<double>(ts.tv_nsec) / 1e3;
+}
+
+template <typename Sleep>
+void measure(const char* label, microseconds target, Sleep&& sleep) {
+    std::vector<double> late(samples);
+    double cpu_per_sleep = 0;
+
+    std::jthread([&] {
+        const double cpu_start = thread_cpu_us();
+        for (int i = 0; i < samples; ++i) {
+            const auto deadline = steady_clock::now() + target;
+            sleep(deadline);
+            late[i] = duration<double, std::micro>(steady_clock::now() - deadline).count();
+        }
+        cpu_per_sleep = (thread_cpu_us() - cpu_start) / samples;
+    }).join();
+
+    std::array<int, bucket_us.size() + 1> histogram{};
+    for (double v : late) {
+        histogram[std::upper_bound(bucket_us.begin(), bucket_us.end(), v) - bucket_us.begin()]++;
+    }
+    std::sort(late.begin(), late.end());
+
+    auto out = sync_cout;
+    char line[160];
+    std::snprintf(line, sizeof line, "  %-22s p50 %8.1fus  p99 %8.1fus  cpu %7.1fus/sleep  |", label,
+                  late[samples / 2], late[samples * 99 / 100], cpu_per_sleep);
+    out << line;
+    for (int count : histogram) {
+        std::snprintf(line, sizeof line, " %5d", count);
+        out << line;
+    }
+    out << '\n';
+}
+
+} // namespace
+
+int main() {
+    sync_cout << "lateness buckets (us):                                                      "
+                 "   <1    <2    <5   <10   <20   <50  <100  <200  <500  >=500\n";
+
+    for (auto target : {50us, 200us, 1000us}) {
+        sync_cout << target.count() << "us target\n";
+        measure("sleep_until", target, [](steady_clock::time_point d) { std::this_thread::sleep_until(d); });
+        measure("sleep_until, slack 1ns", target, [](steady_clock::time_point d) {
+            static thread_local bool once = async::set_timer_slack(1ns);
+            (void)once;
+            std::this_thread::sleep_until(d);
+        });
+        measure("precise_sleep_until", target, [](steady_clock::time_point d) { async::precise_sleep_until(d); });
+    }
+
+    return 0;
+}
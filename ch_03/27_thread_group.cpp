@@ -0,0 +1,92 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/thread_group.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Shutdown time for 1000 threads with staggered wind-down.
+ *
+ * @details
+ * Every thread idles until stop is requested, then needs a staggered
+ * 0..1.9ms to wind down (flush, close, ...). Measured is the time from the
+ * start of shutdown until every thread is joined:
+ *
+ * - vector<jthread>:             each destructor requests stop on its own
+ *                                thread and joins it, one after another
+ *                                (what JthreadWrapper in 08_jthread.cpp does)
+ * - shared stop + serial join:   one stop_source, then join() in order
+ * - thread_group:                request_stop_all() + one completion counter
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 27_thread_group.cpp -o exec/27_thread_group
+ */
+
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr std::size_t threads = 1000;
+
+void service(std::stop_token st, std::size_t i) {
+    std::mutex mtx;
+    std::condition_variable_any cv;
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, st, [] { return false; });   // idle until stop is requested
+    std::this_thread::sleep_for(microseconds(100 * (i % 20)));   // staggered wind-down
+}
+
+double ms_since(steady_clock::time_point start) {
+    return duration<double, std::milli>(steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    {
+        auto pool = std::make_unique<std::vector<std::jthread>>();
+        for (std::size_t i = 0; i < threads; ++i) pool->emplace_back(service, i);
+        std::this_thread::sleep_for(100ms);
+
+        const auto start = steady_clock::now();
+        pool.reset();
+        sync_cout << "vector<jthread>:            " << ms_since(start) << "ms\n";
+    }
+
+    {
+        std::stop_source stop;
+        std::vector<std::thread> pool;
+        for (std::size_t i = 0; i < threads; ++i) pool.emplace_back(service, stop.get_token(), i);
+        std::this_thread::sleep_for(100ms);
+
+        const auto start = steady_clock::now();
+        stop.request_stop();
+        for (auto& t : pool) t.join();
+        sync_cout << "shared stop + serial join:  " << ms_since(start) << "ms\n";
+    }
+
+    {
+        async::thread_group group;
+        for (std::size_t i = 0; i < threads; ++i) group.spawn(service, i);
+        std::this_thread::sleep_for(100ms);
+
+        const auto start = steady_clock::now();
+        group.request_stop_all();
+        group.wait();
+        const double all_done = ms_since(start);
+        group.join_all();
+        sync_cout << "thread_group:               " << ms_since(start) << "ms (last thread done after "
+                  << all_done << "ms)\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <stop_token>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/cancellation.hpp"
+#include "include/channel.hpp"
+#include "include/fast_future.hpp"
+#include "include/fast_rng.hpp"
+#include "include/thread_pool.hpp"
+#include "include/timer_wheel.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Latency from request_stop() to the stopped code noticing it.
+ *
+ * @details
+ * Every trial parks an observer in one blocking call, requests stop and
+ * measures until the call has returned on the observer's thread:
+ * - polling sleep:     `while (!stop_requested()) sleep_for(100ms)`, the
+ *                      09_move_threads.cpp pattern with a shorter period,
+ *                      stopped at a random phase
+ * - async::sleep_for:  futex sleep woken by a stop_callback
+ * - channel::recv(st): empty channel
+ * - stoppable_mutex:   lock(st) while another thread holds the mutex
+ * - future::get(st):   promise never fulfilled
+ * - pool task:         spawn(pool, st, fn) with fn in async::sleep_for(st, 1s)
+ *
+ * Finally, timers scheduled with a token are freed by request_stop()
+ * itself; the pending count is printed before and after.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 30_cancellation.cpp -o exec/30_cancellation
+ */
+
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int trials = 200;
+
+// Runs `observe` on its own thread until stop; returns request_stop -> return latencies in us
+std::vector<double> measure(int n, const std::function<void(std::stop_token)>& observe,
+                            const std::function<steady_clock::duration()>& settle = [] { return 2ms; }) {
+    std::vector<double> out;
+    for (int i = 0; i < n; ++i) {
+        std::stop_source stop;
+        std::atomic<std::int64_t> observed{0};
+        std::jthread observer([&] {
+            observe(stop.get_token());
+            observed.store(steady_clock::now().time_since_epoch().count(), std::memory_order_release);
+        });
+        std::this_thread::sleep_for(settle());
+        const auto requested = steady_clock::now();
+        stop.request_stop();
+        observer.join();
+        out.push_back(duration<double, std::micro>(
+                          steady_clock::time_point(steady_clock::duration(observed.load())) - requested)
+                          .count());
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+void print(const char* name, const std::vector<double>& us) {
+    char line[128];
+    std::snprintf(line, sizeof line, "%-20s %10.1f %10.1f %10.1f\n", name, us[us.size() / 2],
+                  us[us.size() * 99 / 100], us.back());
+    sync_cout << line;
+}
+
+} // namespace
+
+int main() {
+    sync_cout << "latency (us)                p50        p99        max\n";
+
+    print("polling sleep", measure(trials / 10, [](std::stop_token st) {
+              while (!st.stop_requested()) std::this_thread::sleep_for(100ms);
+          }, [] { return milliseconds(2 + async::random_below(100)); }));
+
+    print("async::sleep_for", measure(trials, [](std::stop_token st) { async::sleep_for(st, 10s); }));
+
+    async::channel<int> ch(16);
+    print("channel::recv(st)", measure(trials, [&](std::stop_token st) { ch.recv(st); }));
+
+    async::stoppable_mutex mtx;
+    mtx.lock();
+    print("stoppable_mutex", measure(trials, [&](std::stop_token st) {
+              if (mtx.lock(st)) mtx.unlock();
+          }));
+    mtx.unlock();
+
+    print("future::get(st)", measure(trials, [](std::stop_token st) {
+              async::fast_promise<int> promise;
+              auto future = promise.get_future();
+              try {
+                  future.get(st);
+              } catch (const async::operation_cancelled&) {}
+          }));
+
+    async::thread_pool pool;
+    print("pool task", measure(trials, [&](std::stop_token st) {
+              auto done = async::spawn(pool, st, [](std::stop_token task_st) { async::sleep_for(task_st, 1s); });
+              done.wait();   // the task itself observed the stop
+          }));
+
+    {
+        async::timer_wheel wheel;
+        std::stop_source stop;
+        for (int i = 0; i < 1000; ++i) wheel.schedule_after(10s, [] {}, stop.get_token());
+        const std::size_t before = wheel.pending();
+        stop.request_stop();
+        sync_cout << "\ntimers pending: " << before << " before request_stop, " << wheel.pending() << " after\n";
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <stop_token>
+#include <syncstream>
+#include <thread>
+
+#include "include/checkpoint.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Cost of stop checks in a tight loop, and how fast they see a stop.
+ *
+ * @details
+ * The loop body is one xorshift step (about a nanosecond). `iterations`
+ * of it run:
+ * - with no stop check at all (the 3s spin in 10_yield_thread.cpp),
+ * - with `stop_requested()` every iteration,
+ * - with `checkpoint` at a fixed stride of 1024,
+ * - with an adaptive `checkpoint` (100us target).
+ * Reported: ns per iteration and the overhead against the unchecked loop.
+ *
+ * Then each checked loop runs on its own thread until stopped, and the
+ * time from `request_stop()` to the loop exiting is printed.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 31_checkpoint.cpp -o exec/31_checkpoint
+ */
+
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr std::uint64_t iterations = 1'000'000'000;
+
+// Gives the overhead runs a token with a real stop state to load
+const std::stop_source never_stopped;
+
+inline std::uint64_t step(std::uint64_t x) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+template <class Continue>
+std::uint64_t spin(std::uint64_t n, Continue&& keep_going) {
+    std::uint64_t x = 88172645463325252ull;
+    for (std::uint64_t i = 0; i < n && keep_going(); ++i) x = step(x);
+    return x;
+}
+
+template <class Make>
+double ns_per_iteration(Make&& make) {
+    auto keep_going = make(never_stopped.get_token());
+    const auto start = steady_clock::now();
+    volatile std::uint64_t sink = spin(iterations, keep_going);
+    (void)sink;
+    return duration<double, std::nano>(steady_clock::now() - start).count() / static_cast<double>(iterations);
+}
+
+template <class Make>
+double stop_latency_us(Make&& make) {
+    std::atomic<std::int64_t> exited{0};
+    std::jthread worker([&](std::stop_token st) {
+        auto keep_going = make(std::move(st));
+        volatile std::uint64_t sink = spin(~std::uint64_t{0}, keep_going);
+        (void)sink;
+        exited.store(steady_clock::now().time_since_epoch().count(), std::memory_order_release);
+    });
+    std::this_thread::sleep_for(50ms);
+    const auto requested = steady_clock::now();
+    worker.request_stop();
+    worker.join();
+    return duration<double, std::micro>(steady_clock::time_point(steady_clock::duration(exited.load())) - requested)
+        .count();
+}
+
+void row(const char* name, double ns, double baseline, double latency_us) {
+    char line[128];
+    std::snprintf(line, sizeof line, "%-22s %8.3f %+9.2f%% %12.1f\n", name, ns, 100.0 * (ns - baseline) / baseline,
+                  latency_us);
+    sync_cout << line;
+}
+
+void row(const char* name, double ns) {
+    char line[128];
+    std::snprintf(line, sizeof line, "%-22s %8.3f %10s %12s\n", name, ns, "-", "never");
+    sync_cout << line;
+}
+
+} // namespace
+
+int main() {
+    auto unchecked = [](std::stop_token) { return [] { return true; }; };
+    auto every_iteration = [](std::stop_token st) { return [st] { return !st.stop_requested(); }; };
+    auto fixed = [](std::stop_token st) {
+        return [cp = async::checkpoint(st, {.every = 1024})] () mutable { return cp(); };
+    };
+    auto adaptive = [](std::stop_token st) {
+        return [cp = async::checkpoint(st)] () mutable { return cp(); };
+    };
+
+    const double base = ns_per_iteration(unchecked);
+    sync_cout << "loop                    ns/iter  overhead  stop->exit us\n";
+    row("no check", base);
+    row("stop_requested()", ns_per_iteration(every_iteration), base, stop_latency_us(every_iteration));
+    row("checkpoint every 1024", ns_per_iteration(fixed), base, stop_latency_us(fixed));
+    row("checkpoint adaptive", ns_per_iteration(adaptive), base, stop_latency_us(adaptive));
+    return 0;
+}
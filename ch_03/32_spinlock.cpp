@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/cpu_relax.hpp"
+#include "include/spinlock.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Lock throughput across critical-section lengths and thread counts.
+ *
+ * @details
+ * Every cell runs `threads` threads for `cell_time`; each thread loops
+ * lock -> critical section -> unlock -> a little private work, and the
+ * total number of critical sections per microsecond is reported. The
+ * critical section is a dependent multiply chain calibrated to roughly
+ * 0 / 25 / 100 / 400ns; the private work is about 50ns.
+ *
+ * Locks:
+ * - std::mutex                 futex-based, sleeps under contention
+ * - TAS                        exchange in a loop, no pause, no backoff
+ * - TTAS + pause               load-spin with cpu_relax(), no backoff
+ * - spinlock                   TTAS + pause + exponential backoff
+ * - spinlock + yield           same, yielding every 16 polls
+ *
+ * With more threads than cores a preempted holder stalls every spinner
+ * for a whole time slice; only std::mutex and the yielding spinlock
+ * degrade gracefully there.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 32_spinlock.cpp -o exec/32_spinlock
+ */
+
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto cell_time = 100ms;
+
+class tas_lock {
+public:
+    void lock() noexcept { while (locked.exchange(true, std::memory_order_acquire)) {} }
+    bool try_lock() noexcept { return !locked.exchange(true, std::memory_order_acquire); }
+    void unlock() noexcept { locked.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> locked{false};
+};
+
+class ttas_lock {
+public:
+    void lock() noexcept {
+        while (locked.exchange(true, std::memory_order_acquire)) {
+            while (locked.load(std::memory_order_relaxed)) async::cpu_relax();
+        }
+    }
+    bool try_lock() noexcept { return !locked.exchange(true, std::memory_order_acquire); }
+    void unlock() noexcept { locked.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> locked{false};
+};
+
+std::uint64_t work(std::uint64_t x, std::uint32_t units) {
+    for (std::uint32_t i = 0; i < units; ++i) x = x * 6364136223846793005ull + 1442695040888963407ull;
+    return x;
+}
+
+double ns_per_unit() {
+    constexpr std::uint32_t units = 50'000'000;
+    const auto start = steady_clock::now();
+    volatile std::uint64_t sink = work(1, units);
+    (void)sink;
+    return duration<double, std::nano>(steady_clock::now() - start).count() / units;
+}
+
+template <class Lock>
+double throughput(Lock& lock, unsigned threads, std::uint32_t cs_units, std::uint32_t private_units) {
+    std::atomic<bool> go{false}, done{false};
+    std::atomic<unsigned> ready{0};
+    std::uint64_t shared = 1;
+    std::vector<std::uint64_t> counts(threads);
+    {
+        std::vector<std::jthread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                std::uint64_t local = t + 1, n = 0;
+                ready.fetch_add(1, std::memory_order_release);
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                while (!done.load(std::memory_order_relaxed)) {
+                    {
+                        std::lock_guard<Lock> guard(lock);
+                        shared = work(shared, cs_units);
+                    }
+                    local = work(local, private_units);
+                    ++n;
+                }
+                counts[t] = n + (local == 0);   // keeps `local` alive
+            });
+        }
+        while (ready.load(std::memory_order_acquire) < threads) std::this_thread::yield();
+        const auto start = steady_clock::now();
+        go.store(true, std::memory_order_release);
+        std::this_thread::sleep_until(start + cell_time);
+        done.store(true, std::memory_order_relaxed);
+    }
+    std::uint64_t total = 0;
+    for (auto c : counts) total += c;
+    return static_cast<double>(total) / duration<double, std::micro>(cell_time).count();
+}
+
+} // namespace
+
+int main() {
+    const double unit_ns = ns_per_unit();
+    const auto units = [&](double ns) { return static_cast<std::uint32_t>(ns / unit_ns + 0.5); };
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> thread_counts{1, 2, 4, 8};
+    if (hw > 8) thread_counts.push_back(hw);
+
+    sync_cout << "critical sections per us (" << hw << " hardware threads)\n";
+    for (double cs_ns : {0.0, 25.0, 100.0, 400.0}) {
+        char label[32], line[160];
+        std::snprintf(label, sizeof label, "cs ~%.0fns", cs_ns);
+        std::snprintf(line, sizeof line, "\n%-13s%-12s %-12s %-12s %-12s %-12s\n", label, "std::mutex", "TAS",
+                      "TTAS+pause", "spinlock", "spin+yield");
+        sync_cout << line;
+        for (unsigned threads : thread_counts) {
+            const std::uint32_t cs = units(cs_ns), priv = units(50.0);
+            std::mutex m;
+            tas_lock tas;
+            ttas_lock ttas;
+            async::spinlock spin;
+            async::spinlock spin_yield({.yield_after = 16});
+            std::snprintf(line, sizeof line, "%3u threads  %-12.2f %-12.2f %-12.2f %-12.2f %-12.2f\n", threads,
+                          throughput(m, threads, cs, priv), throughput(tas, threads, cs, priv),
+                          throughput(ttas, threads, cs, priv), throughput(spin, threads, cs, priv),
+                          throughput(spin_yield, threads, cs, priv));
+            sync_cout << line;
+        }
+    }
+    return 0;
+}
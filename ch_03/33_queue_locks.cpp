@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <syncstream>
+#include <thread>
+#include <vector>
+
+#include "include/queue_locks.hpp"
+#include "include/spinlock.hpp"
+
+#define sync_cout std::osyncstream(std::cout)
+
+/**
+ * @brief Throughput and fairness of FIFO locks under heavy contention.
+ *
+ * @details
+ * 2..128 threads hammer one lock for `cell_time`: lock, a short critical
+ * section (a few dependent multiplies on shared data), unlock, a little
+ * private work. Per lock and thread count:
+ * - Mops/s:   total acquisitions per microsecond of wall time
+ * - min, max: fewest / most acquisitions made by a single thread
+ * - spread:   max / min (1.0 = perfectly even; "inf" = a thread starved)
+ * - max wait: longest single lock() call, in microseconds
+ *
+ * std::mutex and spinlock let a releasing thread take the lock straight
+ * back, which shows up as a large spread. ticket, MCS and CLH hand it over
+ * in arrival order; MCS and CLH waiters spin on separate cache lines.
+ * With more threads than cores a FIFO lock must wait for the next thread
+ * in line to be scheduled, so its throughput collapses there. A preempted
+ * waiter also stalls everyone queued behind it, so per-thread counts then
+ * follow the scheduler's time slices rather than arrival order and the
+ * spread can be as large as for std::mutex; compare fairness only at
+ * thread counts up to the core count.
+ *
+ * Build:  g++ -std=c++20 -O2 -pthread 33_queue_locks.cpp -o exec/33_queue_locks
+ */
+
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto cell_time = 100ms;
+
+std::atomic<std::uint64_t> sink{0};   // keeps the private work alive
+
+struct result {
+    double mops;
+    std::uint64_t min;
+    std::uint64_t max;
+    double max_wait_us;
+};
+
+std::uint64_t work(std::uint64_t x, int units) {
+    for (int i = 0; i < units; ++i) x = x * 6364136223846793005ull + 1442695040888963407ull;
+    return x;
+}
+
+template <class Lock>
+result run(unsigned threads) {
+    Lock lock;
+    std::atomic<bool> go{false}, done{false};
+    std::atomic<unsigned> ready{0};
+    std::uint64_t shared = 1, entries = 0;
+    std::vector<std::uint64_t> counts(threads);
+    std::vector<steady_clock::duration> waits(threads);
+    {
+        std::vector<std::jthread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                std::uint64_t local = t + 1, n = 0;
+                steady_clock::duration longest{};
+                ready.fetch_add(1, std::memory_order_release);
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                while (!done.load(std::memory_order_relaxed)) {
+                    const auto before = steady_clock::now();
+                    lock.lock();
+                    longest = std::max(longest, steady_clock::now() - before);
+                    shared = work(shared, 8);
+                    ++entries;
+                    lock.unlock();
+                    local = work(local, 32);
+                    ++n;
+                }
+                counts[t] = n;
+                sink += local;
+                waits[t] = longest;
+            });
+        }
+        while (ready.load(std::memory_order_acquire) < threads) std::this_thread::yield();
+        const auto start = steady_clock::now();
+        go.store(true, std::memory_order_release);
+        std::this_thread::sleep_until(start + cell_time);
+        done.store(true, std::memory_order_relaxed);
+    }
+    std::uint64_t total = 0;
+    for (auto c : counts) total += c;
+    if (total != entries) sync_cout << "lost updates!\n";
+    return {static_cast<double>(total) / duration<double, std::micro>(cell_time).count(),
+            *std::min_element(counts.begin(), counts.end()), *std::max_element(counts.begin(), counts.end()),
+            duration<double, std::micro>(*std::max_element(waits.begin(), waits.end())).count()};
+}
+
+template <class Lock>
+void table(const char* name) {
+    sync_cout << '\n' << name << "\nthreads     Mops/s        min        max   spread  max wait us\n";
+    for (unsigned threads = 2; threads <= 128; threads *= 2) {
+        const result r = run<Lock>(threads);
+        char spread[16];
+        if (r.min == 0) {
+            std::snprintf(spread, sizeof spread, "inf");
+        } else {
+            std::snprintf(spread, sizeof spread, "%.2f", static_cast<double>(r.max) / static_cast<double>(r.min));
+        }
+        char line[128];
+        std::snprintf(line, sizeof line, "%7u %10.2f %10llu %10llu %8s %12.1f\n", threads, r.mops,
+                      static_cast<unsigned long long>(r.min), static_cast<unsigned long long>(r.max), spread,
+                      r.max_wait_us);
+        sync_cout << line;
+    }
+}
+
+} // namespace
+
+int main() {
+    sync_cout << std::thread::hardware_concurrency() << " hardware threads\n";
+    table<std::mutex>("std::mutex");
+    table<async::spinlock>("spinlock (TTAS + backoff)");
+    table<async::ticket_lock>("ticket_lock");
+    table<async::mcs_lock>("mcs_lock");
+    table<async::clh_lock>("clh_lock");
+    return 0;
+}
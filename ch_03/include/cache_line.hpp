@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Cache-line size used for padding and alignment.
+ *
+ * @details
+ * Data written by different threads goes on separate cache lines so that
+ * one writer's stores do not invalidate the line under the others (false
+ * sharing). 64 bytes is the line size on current x86 and most AArch64
+ * cores. `std::hardware_destructive_interference_size` would be the
+ * standard spelling, but GCC warns that its value may differ between
+ * compilations, and a header-only library cannot let its layout depend on
+ * compiler flags.
+ */
+
+namespace async {
+
+inline constexpr std::size_t cache_line_size = 64;
+
+} // namespace async
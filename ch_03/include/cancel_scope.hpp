@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <utility>
+
+#include "cancellation.hpp"
+#include "timer_wheel.hpp"
+
+/**
+ * @brief Tree of cancellation scopes with optional deadlines.
+ *
+ * @details
+ * A `cancel_scope` owns a std::stop_source. A child scope registers one
+ * `std::stop_callback` on its parent's token that cancels the child, so
+ * cancelling a request cancels every task below it, level by level.
+ * Registering and deregistering a stop_callback are O(1) list operations;
+ * no child list is kept and nothing is walked on the check path.
+ * `cancelled()` is the token's `stop_requested()`, a single atomic load.
+ *
+ * A scope may carry a deadline. Its effective deadline is the earlier of
+ * its own and its parent's, and a timer is only armed when its own
+ * deadline comes first; otherwise the parent's timer will cancel it
+ * anyway. Timers go to a timer_wheel (a shared 1ms wheel unless one is
+ * passed in) and are scheduled with the scope's own token, so a scope
+ * cancelled early frees its timer at once (see timer_wheel::schedule_at).
+ *
+ * `reason()` tells why the scope was cancelled: `cancel()`, the parent,
+ * or the deadline; the first cause wins.
+ *
+ * `cancel_scope child(async::child_of, parent)` creates a child; the tag
+ * keeps that apart from copying. Scopes can be neither copied nor moved
+ * (like std::stop_callback, they are registered by address). A child must
+ * not outlive its parent.
+ *
+ * @code
+ * async::cancel_scope request(steady_clock::now() + 200ms);
+ * auto query = async::spawn(pool, request.token(), run_query);
+ *
+ * async::cancel_scope render(async::child_of, request);
+ * while (!render.cancelled()) emit_row();
+ * @endcode
+ */
+
+namespace async {
+
+enum class cancel_reason : std::uint8_t { none, requested, parent, deadline };
+
+struct child_of_t {
+    explicit child_of_t() = default;
+};
+
+inline constexpr child_of_t child_of{};
+
+inline const char* to_string(cancel_reason r) {
+    switch (r) {
+        case cancel_reason::none: return "none";
+        case cancel_reason::requested: return "requested";
+        case cancel_reason::parent: return "parent";
+        case cancel_reason::deadline: return "deadline";
+    }
+    return "?";
+}
+
+namespace detail {
+
+struct scope_state {
+    std::stop_source source;
+    std::atomic<cancel_reason> reason{cancel_reason::none};
+
+    void cancel(cancel_reason why) {
+        auto expected = cancel_reason::none;
+        reason.compare_exchange_strong(expected, why, std::memory_order_relaxed);
+        source.request_stop();   // publishes `reason` to whoever observes the stop
+    }
+};
+
+struct cancel_child {
+    scope_state* child;
+    void operator()() const { child->cancel(cancel_reason::parent); }
+};
+
+inline timer_wheel& deadline_timers() {
+    static timer_wheel wheel;
+    return wheel;
+}
+
+} // namespace detail
+
+class cancel_scope {
+public:
+    using clock = std::chrono::steady_clock;
+
+    cancel_scope() = default;
+
+    explicit cancel_scope(clock::time_point deadline, timer_wheel* timers = nullptr) {
+        arm(deadline, timers);
+    }
+
+    cancel_scope(child_of_t, const cancel_scope& parent) : until(parent.until) { link(parent); }
+
+    cancel_scope(child_of_t, const cancel_scope& parent, clock::time_point deadline, timer_wheel* timers = nullptr)
+        : until(parent.until) {
+        link(parent);
+        arm(deadline, timers);
+    }
+
+    ~cancel_scope() {
+        parent_link.reset();
+        if (wheel) wheel->cancel(timer);
+    }
+
+    cancel_scope(const cancel_scope&) = delete;
+    cancel_scope& operator=(const cancel_scope&) = delete;
+
+    void cancel() { state->cancel(cancel_reason::requested); }
+
+    bool cancelled() const noexcept { return stop.stop_requested(); }
+
+    // Throws operation_cancelled once cancelled
+    void check() const {
+        if (cancelled()) throw operation_cancelled();
+    }
+
+    std::stop_token token() const noexcept { return stop; }
+
+    cancel_reason reason() const { return state->reason.load(std::memory_order_relaxed); }
+
+    // Earliest of this scope's and its ancestors' deadlines
+    std::optional<clock::time_point> deadline() const { return until; }
+
+private:
+    void link(const cancel_scope& parent) {
+        parent_link.emplace(parent.stop, detail::cancel_child{state.get()});
+    }
+
+    void arm(clock::time_point deadline, timer_wheel* timers) {
+        if (until && *until <= deadline) return;   // an ancestor's timer fires first
+        until = deadline;
+        if (cancelled()) return;
+        wheel = timers ? timers : &detail::deadline_timers();
+        timer = wheel->schedule_at(deadline, [s = state] { s->cancel(cancel_reason::deadline); }, stop);
+    }
+
+    std::shared_ptr<detail::scope_state> state = std::make_shared<detail::scope_state>();
+    std::stop_token stop = state->source.get_token();
+    std::optional<clock::time_point> until;
+    std::optional<std::stop_callback<detail::cancel_child>> parent_link;
+    timer_wheel* wheel = nullptr;
+    timer_wheel::timer_id timer = timer_wheel::invalid_timer;
+};
+
+} // namespace async
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stop_token>
+#include <utility>
+
+#include "cpu_relax.hpp"
+#include "futex.hpp"
+
+/**
+ * @brief Cooperative cancellation on top of std::stop_token.
+ *
+ * @details
+ * A thread that sleeps in `std::this_thread::sleep_for(1s)` chunks
+ * (09_move_threads.cpp) notices a stop request only at its next chunk
+ * boundary. The waits here take a `std::stop_token` and register a
+ * `std::stop_callback` that wakes the waiter directly, so `request_stop()`
+ * is observed within microseconds:
+ *
+ * - `sleep_for(st, d)` / `sleep_until(st, tp)`: parks on a futex word
+ *   (`detail::parked_waiter`) that the callback signals. Returns false if
+ *   woken by the stop request.
+ * - `stoppable_mutex::lock(st)`: a Lockable mutex whose contended path
+ *   waits in `condition_variable_any::wait(lock, st, pred)`. Uncontended
+ *   lock/unlock is one exchange / one store; unlock only takes the
+ *   internal mutex when a waiter registered.
+ *
+ * Elsewhere in the tree the same token is accepted by
+ * `channel::recv(st)` / `send(v, st)`, `fast_future::wait(st)` /
+ * `get(st)`, `thread_pool::submit(st, fn)`, `spawn(pool, st, fn)` and
+ * `timer_wheel::schedule_at(tp, fn, st)`. Calls that return a value
+ * report cancellation as `operation_cancelled`.
+ *
+ * @code
+ * std::jthread worker([](std::stop_token st) {
+ *     while (async::sleep_for(st, 1s)) poll();
+ * });
+ * @endcode
+ */
+
+namespace async {
+
+class operation_cancelled : public std::exception {
+public:
+    const char* what() const noexcept override { return "operation cancelled"; }
+};
+
+// True if the full duration elapsed, false if stop was requested first
+inline bool sleep_until(std::stop_token st, std::chrono::steady_clock::time_point deadline) {
+    if (st.stop_requested()) return false;
+    detail::parked_waiter waiter;
+    std::stop_callback wake(st, [&] { waiter.signal(); });
+    return !waiter.wait_until(deadline);
+}
+
+template <class Rep, class Period>
+bool sleep_for(std::stop_token st, std::chrono::duration<Rep, Period> d) {
+    return sleep_until(std::move(st), std::chrono::steady_clock::now() +
+                                          std::chrono::ceil<std::chrono::steady_clock::duration>(d));
+}
+
+class stoppable_mutex {
+public:
+    stoppable_mutex() = default;
+    stoppable_mutex(const stoppable_mutex&) = delete;
+    stoppable_mutex& operator=(const stoppable_mutex&) = delete;
+
+    bool try_lock() noexcept {
+        return !held.load(std::memory_order_relaxed) && !held.exchange(true, std::memory_order_acquire);
+    }
+
+    void lock() { lock(std::stop_token{}); }
+
+    // False if stop was requested before the mutex could be taken
+    bool lock(std::stop_token st) {
+        for (int i = 0; i < spins; ++i) {
+            if (try_lock()) return true;
+            cpu_relax();
+        }
+        std::unique_lock<std::mutex> guard(mtx);
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);   // pairs with the fence in unlock()
+        const bool locked = cv.wait(guard, st, [&] { return try_lock(); });
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        return locked;
+    }
+
+    void unlock() {
+        held.store(false, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) == 0) return;
+        { std::lock_guard<std::mutex> guard(mtx); }   // a registered waiter is now parked or re-checking
+        cv.notify_one();
+    }
+
+private:
+    static constexpr int spins = 64;
+
+    std::atomic<bool> held{false};
+    std::atomic<std::uint32_t> waiters{0};
+    std::mutex mtx;
+    std::condition_variable_any cv;
+};
+
+} // namespace async
@@ -0,0 +1,313 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cache_line.hpp"
+#include "futex.hpp"
+
+/**
+ * @brief Bounded multi-producer/multi-consumer channel.
+ *
+ * @details
+ * A thread in 06_return_vals.cpp can hand back exactly one value. A
+ * `channel<T>` lets any number of producers stream values to any number
+ * of consumers.
+ *
+ * The buffer is Dmitry Vyukov's bounded MPMC ring: every cell carries a
+ * sequence number that tells producers and consumers whose turn it is, so
+ * a send or receive is one CAS on the shared position plus one release
+ * store on the cell, with no lock. Capacity is rounded up to a power of
+ * two. Enqueue and dequeue positions live on separate cache lines.
+ *
+ * Blocking:
+ * - `send()` / `recv()` retry `try_send()` / `try_recv()` (a few spins,
+ *   then a few yields) and park in `atomic::wait` on an epoch counter when
+ *   the ring stays full / empty.
+ * - The opposite side only bumps the epoch and calls `notify_one` when a
+ *   waiter has registered, so the uncontended path makes no syscalls.
+ *   Registration and the producer's check are ordered by seq_cst fences
+ *   (Dekker style), so a wakeup cannot be lost.
+ *
+ * Closing: `close()` sets a bit in the enqueue position, so the claiming
+ * CAS of any later send fails and no slot can be claimed once closed.
+ * Receivers drain what is left, including values whose senders claimed a
+ * slot before the close and are still writing it; `recv()` returns
+ * std::nullopt only when every accepted send has been received.
+ *
+ * Cancellation: `send(v, st)` / `recv(st)` also give up once `st` is
+ * stopped. A stop callback bumps the epoch and wakes every parked caller
+ * on that side; the others re-check and park again.
+ *
+ * `async::select` (select.hpp) parks one `parked_waiter` on several
+ * channels through `add_recv_waiter()`; such waiters count as registered
+ * receivers and are signalled on every send and on close.
+ *
+ * @code
+ * async::channel<int> ch(1024);
+ * std::jthread producer([&] { for (int i = 0; i < 100; ++i) ch.send(i); ch.close(); });
+ * while (auto v = ch.recv()) use(*v);
+ * @endcode
+ */
+
+namespace async {
+
+template <class T>
+class channel {
+public:
+    explicit channel(std::size_t capacity)
+        : mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+          cells(std::make_unique<cell[]>(mask + 1)) {
+        for (std::size_t i = 0; i <= mask; ++i) cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    ~channel() {
+        while (try_recv()) { }
+    }
+
+    channel(const channel&) = delete;
+    channel& operator=(const channel&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+
+    // Fails if the channel is full or closed
+    template <class U>
+    bool try_send(U&& value) {
+        std::size_t pos = enqueue_pos.value.load(std::memory_order_relaxed);
+        cell* c;
+        while (true) {
+            if (pos & closed_bit) return false;
+            c = &cells[pos & mask];
+            const std::size_t seq = c->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // full
+            } else {
+                pos = enqueue_pos.value.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (c->storage) T(std::forward<U>(value));
+        c->seq.store(pos + 1, std::memory_order_release);
+        wake(not_empty);
+        return true;
+    }
+
+    // Empty optional if nothing is buffered right now
+    std::optional<T> try_recv() {
+        std::size_t pos = dequeue_pos.value.load(std::memory_order_relaxed);
+        cell* c;
+        while (true) {
+            c = &cells[pos & mask];
+            const std::size_t seq = c->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return std::nullopt;   // empty
+            } else {
+                pos = dequeue_pos.value.load(std::memory_order_relaxed);
+            }
+        }
+        T* slot = std::launder(reinterpret_cast<T*>(c->storage));
+        std::optional<T> value(std::move(*slot));
+        slot->~T();
+        c->seq.store(pos + mask + 1, std::memory_order_release);
+        wake(not_full);
+        return value;
+    }
+
+    // Blocks while full; false if the channel is (or becomes) closed
+    template <class U>
+    bool send(U&& value) {
+        return block_until(not_full, [&] { return try_send(std::forward<U>(value)); },
+                           [&] { return is_closed(); });
+    }
+
+    // Blocks while full; false if the channel is closed or `st` is stopped first
+    template <class U>
+    bool send(U&& value, std::stop_token st) {
+        std::stop_callback wake(st, [this] { interrupt(not_full); });
+        return block_until(not_full, [&] { return try_send(std::forward<U>(value)); },
+                           [&] { return is_closed() || st.stop_requested(); });
+    }
+
+    // Blocks while empty; std::nullopt once closed and drained
+    std::optional<T> recv() {
+        std::optional<T> out;
+        block_until(not_empty, [&] { return (out = try_recv()).has_value(); },
+                    [&] { return drained(); });
+        return out;
+    }
+
+    // As recv(), but also std::nullopt once `st` is stopped
+    std::optional<T> recv(std::stop_token st) {
+        std::optional<T> out;
+        std::stop_callback wake(st, [this] { interrupt(not_empty); });
+        block_until(not_empty, [&] { return (out = try_recv()).has_value(); },
+                    [&] { return drained() || st.stop_requested(); });
+        return out;
+    }
+
+    /**
+     * Blocks for the first value, then takes up to `max - 1` more without
+     * blocking. Returns the number written to `out` (0 = closed and drained).
+     */
+    template <class OutIt>
+    std::size_t recv_batch(OutIt out, std::size_t max) {
+        if (max == 0) return 0;
+        auto first = recv();
+        if (!first) return 0;
+        *out++ = std::move(*first);
+        return 1 + try_recv_batch(out, max - 1);
+    }
+
+    template <class OutIt>
+    std::size_t try_recv_batch(OutIt out, std::size_t max) {
+        std::size_t n = 0;
+        for (; n < max; ++n) {
+            auto v = try_recv();
+            if (!v) break;
+            *out++ = std::move(*v);
+        }
+        return n;
+    }
+
+    void close() {
+        enqueue_pos.value.fetch_or(closed_bit, std::memory_order_seq_cst);
+        for (auto* w : {&not_empty, &not_full}) {
+            w->epoch.fetch_add(1, std::memory_order_seq_cst);
+            w->epoch.notify_all();
+            signal_parked(*w);
+        }
+    }
+
+    // Signals `w` whenever a value is sent or the channel closes. The caller
+    // must re-check try_recv() after registering and before parking.
+    void add_recv_waiter(detail::parked_waiter* w) {
+        {
+            std::lock_guard<std::mutex> lock(not_empty.parked_mtx);
+            not_empty.parked.push_back(w);
+        }
+        not_empty.parked_count.fetch_add(1, std::memory_order_relaxed);
+        not_empty.waiters.fetch_add(1, std::memory_order_seq_cst);
+        // Pairs with the fence in wake(), as in block_until: either the
+        // sender sees this waiter or the caller's re-check sees the value
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    // After this returns, `w` is no longer signalled and may be destroyed
+    void remove_recv_waiter(detail::parked_waiter* w) {
+        not_empty.waiters.fetch_sub(1, std::memory_order_relaxed);
+        not_empty.parked_count.fetch_sub(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(not_empty.parked_mtx);
+        std::erase(not_empty.parked, w);
+    }
+
+    bool is_closed() const { return (enqueue_pos.value.load(std::memory_order_acquire) & closed_bit) != 0; }
+
+    // Closed, and every send that succeeded has been received
+    bool drained() const {
+        const std::size_t enq = enqueue_pos.value.load(std::memory_order_acquire);   // frozen once closed
+        return (enq & closed_bit) && dequeue_pos.value.load(std::memory_order_acquire) == (enq & ~closed_bit);
+    }
+
+    // Snapshot; may be stale by the time it returns
+    bool empty() const {
+        const std::size_t pos = dequeue_pos.value.load(std::memory_order_acquire);
+        return cells[pos & mask].seq.load(std::memory_order_acquire) != pos + 1;
+    }
+
+private:
+    static constexpr std::size_t closed_bit = std::size_t{1} << (std::numeric_limits<std::size_t>::digits - 1);
+
+    struct cell {
+        std::atomic<std::size_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct alignas(cache_line_size) position {
+        std::atomic<std::size_t> value{0};
+    };
+
+    struct alignas(cache_line_size) waitpoint {
+        std::atomic<std::uint32_t> epoch{0};
+        std::atomic<std::uint32_t> waiters{0};   // blocked callers + parked selectors
+
+        std::atomic<std::uint32_t> parked_count{0};
+        std::mutex parked_mtx;
+        std::vector<detail::parked_waiter*> parked;
+    };
+
+    static void wake(waitpoint& w) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (w.waiters.load(std::memory_order_acquire) != 0) {
+            w.epoch.fetch_add(1, std::memory_order_seq_cst);
+            w.epoch.notify_one();
+            signal_parked(w);
+        }
+    }
+
+    static void interrupt(waitpoint& w) {
+        w.epoch.fetch_add(1, std::memory_order_seq_cst);
+        w.epoch.notify_all();
+    }
+
+    static void signal_parked(waitpoint& w) {
+        if (w.parked_count.load(std::memory_order_relaxed) == 0) return;
+        std::lock_guard<std::mutex> lock(w.parked_mtx);
+        for (auto* p : w.parked) p->signal();
+    }
+
+    // Retries `attempt` until it succeeds or `give_up` holds, parking on `w`
+    template <class Attempt, class GiveUp>
+    static bool block_until(waitpoint& w, Attempt&& attempt, GiveUp&& give_up) {
+        constexpr int spins = 16;
+        constexpr int yields = 32;
+        while (true) {
+            for (int i = 0; i < spins + yields; ++i) {
+                if (attempt()) return true;
+                if (give_up()) return false;
+                if (i >= spins) std::this_thread::yield();
+            }
+
+            w.waiters.fetch_add(1, std::memory_order_seq_cst);
+            const std::uint32_t epoch = w.epoch.load(std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (attempt()) {
+                w.waiters.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            if (give_up()) {
+                w.waiters.fetch_sub(1, std::memory_order_relaxed);
+                return false;
+            }
+            w.epoch.wait(epoch, std::memory_order_seq_cst);
+            w.waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    const std::size_t mask;
+    std::unique_ptr<cell[]> cells;
+
+    position enqueue_pos;
+    position dequeue_pos;
+    waitpoint not_empty;
+    waitpoint not_full;
+};
+
+} // namespace async
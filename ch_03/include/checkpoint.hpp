@@ -0,0 +1,142 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Cheap cancellation and yield points for compute loops.
+ *
+ * @details
+ * A loop that never blocks cannot be woken by a stop_callback; it has to
+ * look at its stop_token itself. Doing that every iteration costs a load
+ * and a branch on a shared cache line per iteration; `checkpoint` does it
+ * every `stride` calls instead:
+ *
+ * - hot path: one decrement and a not-taken branch on a counter local to
+ *   the checkpoint object;
+ * - every `stride` calls: the stop check, a cycle-counter read (rdtsc on
+ *   x86, steady_clock elsewhere) and, if `yield_after` has passed since
+ *   the last yield, `std::this_thread::yield()`.
+ *
+ * With `every == 0` the stride adapts so that checks land roughly every
+ * `interval` whatever the loop body costs: it doubles while checks come
+ * in under half the interval and halves when they are over twice it. The
+ * stop latency is then about `interval`, independent of the body. A fixed
+ * `every` skips the clock entirely.
+ *
+ * The TSC rate is calibrated once per process against steady_clock
+ * (about 1ms, on first use); the TSC is only used for short differences
+ * on one thread.
+ *
+ * @code
+ * async::checkpoint checkpoint(st);
+ * for (std::size_t i = 0; i < n && checkpoint(); ++i) out[i] = f(in[i]);
+ * @endcode
+ */
+
+namespace async {
+
+struct checkpoint_options {
+    std::uint32_t every = 0;                    // check every N calls; 0 = adapt to `interval`
+    std::chrono::microseconds interval{100};    // adaptive target between checks
+    std::chrono::microseconds yield_after{0};   // 0 = never yield
+};
+
+namespace detail {
+
+inline std::uint64_t cycles() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+inline double cycles_per_us() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const double rate = [] {
+        using clock = std::chrono::steady_clock;
+        const auto t0 = clock::now();
+        const std::uint64_t c0 = __rdtsc();
+        while (clock::now() - t0 < std::chrono::milliseconds(1)) {}
+        const std::uint64_t c1 = __rdtsc();
+        return static_cast<double>(c1 - c0) / std::chrono::duration<double, std::micro>(clock::now() - t0).count();
+    }();
+    return rate;
+#else
+    return 1e-6 * static_cast<double>(std::chrono::steady_clock::period::den) / std::chrono::steady_clock::period::num;
+#endif
+}
+
+} // namespace detail
+
+class checkpoint {
+public:
+    explicit checkpoint(std::stop_token st, checkpoint_options opts = {})
+        : token(std::move(st)), stride(opts.every ? opts.every : initial_stride), countdown(stride),
+          adaptive(opts.every == 0) {
+        if (adaptive || opts.yield_after.count() > 0) {
+            const double rate = detail::cycles_per_us();
+            target = static_cast<std::uint64_t>(rate * static_cast<double>(opts.interval.count()));
+            yield_cycles = static_cast<std::uint64_t>(rate * static_cast<double>(opts.yield_after.count()));
+            last_check = last_yield = detail::cycles();
+        }
+    }
+
+    // False once stop was requested (seen at the latest one stride later)
+    bool operator()() {
+        if (--countdown != 0) [[likely]] return true;
+        return slow_path();
+    }
+
+    bool stop_requested() const noexcept { return token.stop_requested(); }
+
+    std::uint32_t current_stride() const noexcept { return stride; }
+
+private:
+    static constexpr std::uint32_t initial_stride = 64;
+    static constexpr std::uint32_t max_stride = 1u << 24;
+
+    [[gnu::noinline]] bool slow_path() {
+        if (token.stop_requested()) {
+            countdown = 1;   // keeps reporting the stop
+            return false;
+        }
+        if (adaptive || yield_cycles) {
+            const std::uint64_t now = detail::cycles();
+            if (adaptive) {
+                const std::uint64_t elapsed = now - last_check;
+                if (elapsed < target / 2 && stride < max_stride) {
+                    stride *= 2;
+                } else if (elapsed > target * 2 && stride > 1) {
+                    stride /= 2;
+                }
+                last_check = now;
+            }
+            if (yield_cycles && now - last_yield >= yield_cycles) {
+                std::this_thread::yield();
+                last_yield = detail::cycles();
+            }
+        }
+        countdown = stride;
+        return true;
+    }
+
+    std::stop_token token;
+    std::uint32_t stride;
+    std::uint32_t countdown;
+    bool adaptive;
+    std::uint64_t target = 0;
+    std::uint64_t yield_cycles = 0;
+    std::uint64_t last_check = 0;
+    std::uint64_t last_yield = 0;
+};
+
+} // namespace async
@@ -0,0 +1,28 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Spin-wait hint for busy loops.
+ *
+ * @details
+ * `pause` on x86 (`yield` on AArch64) tells the core it is in a spin loop:
+ * it stops speculating past the loop exit, which avoids the memory-order
+ * machine clear when the awaited value finally changes, and yields
+ * execution resources to the sibling hyper-thread. On other targets it is
+ * a no-op.
+ */
+
+namespace async {
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+} // namespace async
@@ -0,0 +1,442 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <new>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "cancellation.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * @brief Lightweight promise/future pair signalled through one atomic word.
+ *
+ * @details
+ * 06_return_vals.cpp hands a result back by writing through
+ * `std::ref(result)` into a global. `std::future` fixes the data race, but
+ * its shared state is always heap-allocated and guarded by a mutex plus a
+ * condition variable.
+ *
+ * `future_state<T>` holds the value (or exception) next to a single
+ * `std::atomic<std::uint32_t>` status word:
+ * - the producer stores the value, then publishes `has_value`/`has_error`
+ *   with one exchange (release);
+ * - a consumer that finds the state empty sets the `waiting` bit and blocks
+ *   in `atomic::wait`; the producer only calls `notify_all` when that bit
+ *   was set, so an uncontended hand-off makes no syscalls.
+ *
+ * The state can live wherever it is convenient:
+ * - `fast_promise<T>()` allocates one reference-counted state, shared by
+ *   the promise and its future (one allocation, no mutex);
+ * - `fast_promise<T>(state)` uses a caller-owned `future_state<T>`, e.g. a
+ *   member of the task object or a local in the waiting frame, with no
+ *   allocation at all. The caller keeps it alive until both ends are gone.
+ *
+ * A promise destroyed without a result stores `broken_promise`, just like
+ * std::promise, and misuse throws the same `std::future_error`s:
+ * `no_state` on a moved-from promise, `future_already_retrieved` on a
+ * second `get_future()`, `promise_already_satisfied` on a second result.
+ *
+ * A caller-owned state may be destroyed by the consumer as soon as it has
+ * the result, while the producer is still inside `notify_all`. Publishing
+ * therefore holds a `publishing` bit in the status word until it is done
+ * with the object, and `~future_state` waits for that bit to clear (a few
+ * instructions, or one futex wake).
+ *
+ * `wait(st)` / `get(st)` stop waiting once `st` is stopped (get() then
+ * throws `operation_cancelled`; the future stays valid). The stop callback
+ * bumps an epoch in the upper bits of the status word so the waiter's
+ * `atomic::wait` returns. `spawn(pool, st, fn)` completes with
+ * `operation_cancelled` without running `fn` if `st` is stopped before the
+ * task starts, and passes `st` to `fn` if it accepts one.
+ *
+ * Continuations: `f.then(fn)` consumes `f` and returns a future for
+ * `fn(value)`. The continuation is stored in the state and a
+ * `has_continuation` bit is set in the same status word; whichever of
+ * attach and publish comes second runs it, so no thread ever blocks on
+ * `get()` to chain work. `then(fn)` runs inline on the completing thread,
+ * `then(pool, fn)` submits it to a pool. An exception in the source skips
+ * `fn` and propagates to the returned future.
+ *
+ * @code
+ * async::fast_future<int> f = async::spawn(pool, [] { return 42; });
+ * int v = f.get();
+ *
+ * async::future_state<int> st;                // no allocation
+ * async::fast_promise<int> p(st);
+ * auto f2 = p.get_future();
+ * pool.submit([p = std::move(p)] () mutable { p.set_value(7); });
+ * f2.get();
+ *
+ * auto len = async::spawn(pool, load_text).then([](std::string s) { return s.size(); });
+ * @endcode
+ */
+
+namespace async {
+
+template <class T> class fast_future;
+template <class T> class fast_promise;
+
+namespace detail {
+
+struct future_access;
+
+// Runs `fn` and stores its result or exception in `promise`
+template <class R, class F>
+void fulfil(fast_promise<R>& promise, F&& fn) {
+    try {
+        if constexpr (std::is_void_v<R>) {
+            std::forward<F>(fn)();
+            promise.set_value();
+        } else {
+            promise.set_value(std::forward<F>(fn)());
+        }
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+template <class F, class T>
+struct continuation_result { using type = std::invoke_result_t<F&, T>; };
+
+template <class F>
+struct continuation_result<F, void> { using type = std::invoke_result_t<F&>; };
+
+} // namespace detail
+
+template <class T>
+class future_state {
+public:
+    using value_type = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    future_state() = default;
+
+    // The producer may still be in publish() when the consumer is done
+    ~future_state() {
+        while (status.load(std::memory_order_acquire) & publishing) std::this_thread::yield();
+    }
+
+    future_state(const future_state&) = delete;
+    future_state& operator=(const future_state&) = delete;
+
+    bool ready() const { return (status.load(std::memory_order_acquire) & done_mask) != 0; }
+
+    void wait() const {
+        std::uint32_t s = status.load(std::memory_order_acquire);
+        while ((s & done_mask) == 0) {
+            if ((s & waiting) == 0) {
+                s = status.fetch_or(waiting, std::memory_order_acq_rel) | waiting;
+                continue;
+            }
+            status.wait(s, std::memory_order_acquire);
+            s = status.load(std::memory_order_acquire);
+        }
+    }
+
+    template <class... Args>
+    void set_value(Args&&... args) {
+        value.emplace(std::forward<Args>(args)...);
+        publish(has_value);
+    }
+
+    void set_exception(std::exception_ptr e) {
+        error = std::move(e);
+        publish(has_error);
+    }
+
+    // False if `st` was stopped before the state became ready
+    bool wait(std::stop_token st) const {
+        if (ready()) return true;
+        std::stop_callback wake(st, [this] {
+            status.fetch_add(stop_epoch, std::memory_order_acq_rel);
+            status.notify_all();
+        });
+        std::uint32_t s = status.load(std::memory_order_acquire);
+        while ((s & done_mask) == 0) {
+            if (st.stop_requested()) return false;
+            if ((s & waiting) == 0) {
+                s = status.fetch_or(waiting, std::memory_order_acq_rel) | waiting;
+                continue;
+            }
+            status.wait(s, std::memory_order_acquire);
+            s = status.load(std::memory_order_acquire);
+        }
+        return true;
+    }
+
+    // Runs `k` once the state is ready: right away if it already is,
+    // otherwise on the thread that publishes the result. One per state.
+    void on_ready(task k) {
+        continuation = std::move(k);
+        if (status.fetch_or(has_continuation, std::memory_order_acq_rel) & done_mask) run_continuation();
+    }
+
+    // Waits, then moves the value out or rethrows the stored exception
+    T get() {
+        wait();
+        if (status.load(std::memory_order_acquire) & has_error) std::rethrow_exception(error);
+        if constexpr (!std::is_void_v<T>) return std::move(*value);
+    }
+
+private:
+    template <class> friend class fast_promise;
+    template <class> friend class fast_future;
+
+    static constexpr std::uint32_t has_value = 1;
+    static constexpr std::uint32_t has_error = 2;
+    static constexpr std::uint32_t done_mask = has_value | has_error;
+    static constexpr std::uint32_t waiting = 4;
+    static constexpr std::uint32_t has_continuation = 8;
+    static constexpr std::uint32_t publishing = 16;        // publish() still uses the object
+    static constexpr std::uint32_t stop_epoch = 1u << 8;   // bumped by wait(st)'s stop callback
+
+    void publish(std::uint32_t bit) {
+        const std::uint32_t old = status.fetch_or(bit | publishing, std::memory_order_acq_rel);
+        if (old & waiting) status.notify_all();
+        status.fetch_and(~publishing, std::memory_order_release);
+        // A state with a continuation has no waiter: its future lives in the continuation
+        if (old & has_continuation) run_continuation();
+    }
+
+    // The continuation usually owns a future referencing this state, so it
+    // is moved out first and may release the state when it goes out of scope
+    void run_continuation() {
+        task k = std::move(continuation);
+        k();
+    }
+
+    // Only used for states allocated by fast_promise. Callers pass the
+    // ownership flag they cached, since a caller-owned state may already be
+    // gone by the time the promise releases it.
+    void add_ref() { refs.fetch_add(1, std::memory_order_relaxed); }
+
+    void release() {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+    }
+
+    mutable std::atomic<std::uint32_t> status{0};
+    std::atomic<std::uint32_t> refs{1};
+    std::optional<value_type> value;
+    std::exception_ptr error;
+    task continuation;
+};
+
+template <class T>
+class fast_future {
+public:
+    fast_future() = default;
+    fast_future(fast_future&& other) noexcept
+        : st(std::exchange(other.st, nullptr)), owned(other.owned) {}
+    fast_future& operator=(fast_future&& other) noexcept {
+        if (this != &other) {
+            reset();
+            st = std::exchange(other.st, nullptr);
+            owned = other.owned;
+        }
+        return *this;
+    }
+    ~fast_future() { reset(); }
+
+    bool valid() const { return st != nullptr; }
+    bool ready() const { return st->ready(); }
+    void wait() const { st->wait(); }
+    bool wait(std::stop_token token) const { return st->wait(std::move(token)); }
+
+    // Single-shot: the future is invalid afterwards
+    T get() {
+        struct releaser {
+            fast_future& f;
+            ~releaser() { f.reset(); }
+        } guard{*this};
+        return st->get();
+    }
+
+    // Throws operation_cancelled, keeping the future valid, if `token` stops first
+    T get(std::stop_token token) {
+        if (!st->wait(std::move(token))) throw operation_cancelled();
+        return get();
+    }
+
+    // Consumes this future; `fn` runs inline on the completing thread
+    template <class F>
+    auto then(F&& fn) {
+        return chain(nullptr, std::forward<F>(fn), priority::normal);
+    }
+
+    // Consumes this future; `fn` is submitted to `pool` once ready
+    template <class F>
+    auto then(thread_pool& pool, F&& fn, priority p = priority::normal) {
+        return chain(&pool, std::forward<F>(fn), p);
+    }
+
+private:
+    template <class> friend class fast_promise;
+    friend struct detail::future_access;
+
+    template <class F>
+    auto chain(thread_pool* pool, F&& fn, priority p) {
+        using R = typename detail::continuation_result<std::decay_t<F>, T>::type;
+
+        fast_promise<R> promise;
+        fast_future<R> result = promise.get_future();
+        future_state<T>* source = st;
+
+        auto run = [src = std::move(*this), fn = std::forward<F>(fn), promise = std::move(promise)] () mutable {
+            detail::fulfil(promise, [&] () -> R {
+                if constexpr (std::is_void_v<T>) {
+                    src.get();
+                    return fn();
+                } else {
+                    return fn(src.get());
+                }
+            });
+        };
+
+        if (pool) {
+            source->on_ready(task([pool, p, run = std::move(run)] () mutable { pool->submit(std::move(run), p); }));
+        } else {
+            source->on_ready(task(std::move(run)));
+        }
+        return result;
+    }
+
+    fast_future(future_state<T>* s, bool heap) : st(s), owned(heap) {
+        if (owned) st->add_ref();
+    }
+
+    void reset() {
+        auto* s = std::exchange(st, nullptr);
+        if (s && owned) s->release();
+    }
+
+    future_state<T>* st = nullptr;
+    bool owned = false;
+};
+
+template <class T>
+class fast_promise {
+public:
+    // Allocates a reference-counted state
+    fast_promise() : st(new future_state<T>), owned(true) {}
+
+    // Uses caller-owned storage; `state` must outlive the promise and future
+    explicit fast_promise(future_state<T>& state) : st(&state) {}
+
+    fast_promise(fast_promise&& other) noexcept
+        : st(std::exchange(other.st, nullptr)), owned(other.owned), retrieved(other.retrieved),
+          satisfied(other.satisfied) {}
+    fast_promise& operator=(fast_promise&& other) noexcept {
+        if (this != &other) {
+            abandon();
+            st = std::exchange(other.st, nullptr);
+            owned = other.owned;
+            retrieved = other.retrieved;
+            satisfied = other.satisfied;
+        }
+        return *this;
+    }
+    ~fast_promise() { abandon(); }
+
+    fast_future<T> get_future() {
+        check_state();
+        if (std::exchange(retrieved, true)) throw std::future_error(std::future_errc::future_already_retrieved);
+        return fast_future<T>(st, owned);
+    }
+
+    // If constructing the value throws, the promise stays unsatisfied
+    template <class... Args>
+    void set_value(Args&&... args) {
+        check_unsatisfied();
+        st->set_value(std::forward<Args>(args)...);
+        satisfied = true;
+    }
+
+    void set_exception(std::exception_ptr e) {
+        check_unsatisfied();
+        st->set_exception(std::move(e));
+        satisfied = true;
+    }
+
+private:
+    void check_state() const {
+        if (!st) throw std::future_error(std::future_errc::no_state);
+    }
+
+    void check_unsatisfied() const {
+        check_state();
+        if (satisfied) throw std::future_error(std::future_errc::promise_already_satisfied);
+    }
+
+    void abandon() {
+        if (!st) return;
+        if (!satisfied) {
+            st->set_exception(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+        }
+        auto* s = std::exchange(st, nullptr);
+        if (owned) s->release();
+    }
+
+    future_state<T>* st;
+    bool owned = false;
+    bool retrieved = false;
+    bool satisfied = false;
+};
+
+/**
+ * Runs `fn` on `pool` and returns a future for its result; exceptions
+ * thrown by `fn` are rethrown from get().
+ */
+template <class F, class R = std::invoke_result_t<std::decay_t<F>&>>
+fast_future<R> spawn(thread_pool& pool, F&& fn, priority p = priority::normal) {
+    fast_promise<R> promise;
+    fast_future<R> future = promise.get_future();
+    pool.submit([promise = std::move(promise), fn = std::forward<F>(fn)] () mutable {
+        detail::fulfil(promise, fn);
+    }, p);
+    return future;
+}
+
+/**
+ * Like spawn(), but skipped with operation_cancelled if `st` is stopped
+ * before the task starts; `fn` receives `st` if it accepts a stop_token.
+ */
+template <class F, class R = typename std::conditional_t<std::is_invocable_v<std::decay_t<F>&, std::stop_token>,
+                                                         std::invoke_result<std::decay_t<F>&, std::stop_token>,
+                                                         std::invoke_result<std::decay_t<F>&>>::type>
+fast_future<R> spawn(thread_pool& pool, std::stop_token st, F&& fn, priority p = priority::normal) {
+    fast_promise<R> promise;
+    fast_future<R> future = promise.get_future();
+    pool.submit([promise = std::move(promise), st = std::move(st), fn = std::forward<F>(fn)] () mutable {
+        if (st.stop_requested()) {
+            promise.set_exception(std::make_exception_ptr(operation_cancelled()));
+            return;
+        }
+        detail::fulfil(promise, [&] () -> R {
+            if constexpr (std::is_invocable_v<std::decay_t<F>&, std::stop_token>) {
+                return fn(st);
+            } else {
+                return fn();
+            }
+        });
+    }, p);
+    return future;
+}
+
+namespace detail {
+
+// Lets the combinators attach continuations without widening fast_future
+struct future_access {
+    template <class T>
+    static future_state<T>* state(fast_future<T>& f) { return f.st; }
+};
+
+} // namespace detail
+
+} // namespace async
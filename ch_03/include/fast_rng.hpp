@@ -0,0 +1,288 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "cache_line.hpp"
+
+/**
+ * @brief Per-thread pseudo-random generators replacing `rand()`.
+ *
+ * @details
+ * glibc's `rand()` keeps one global state behind a lock, so every worker
+ * that draws a number (func() in 06_return_vals.cpp, the `work` lambda in
+ * 10_yield_thread.cpp) serializes on it.
+ *
+ * Generators (all satisfy UniformRandomBitGenerator):
+ * - `splitmix64`:   64-bit state, used to expand seeds
+ * - `xoshiro256ss`: xoshiro256**, 256-bit state, the default
+ * - `pcg32`:        PCG-XSH-RR, 64-bit state, 32-bit output
+ *
+ * `thread_rng()` returns a thread_local xoshiro256** seeded from the
+ * global seed plus a thread index. Indices are handed out in order of
+ * first use; call `seed_thread_rng(i)` at thread start for a stream that
+ * does not depend on scheduling.
+ *
+ * Bounded draws use Lemire's multiply-shift method, which only divides in
+ * the rare rejection case. `uniform01()` takes the top 53 (or 24) bits.
+ *
+ * `fill()` runs eight independent xoshiro256** lanes in structure-of-arrays
+ * form so the compiler vectorizes the state update (AVX2/AVX-512 with
+ * -march=native). Each call seeds the lanes from eight draws of the
+ * thread's generator.
+ *
+ * @code
+ * async::set_global_seed(1234);               // before starting workers
+ * int roll = 1 + static_cast<int>(async::random_below(6));
+ * double p = async::uniform01(async::thread_rng());
+ * @endcode
+ */
+
+namespace async {
+
+namespace detail {
+
+constexpr std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+} // namespace detail
+
+class splitmix64 {
+public:
+    using result_type = std::uint64_t;
+
+    explicit splitmix64(std::uint64_t seed = 0) : state(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+private:
+    std::uint64_t state;
+};
+
+class xoshiro256ss {
+public:
+    using result_type = std::uint64_t;
+
+    explicit xoshiro256ss(std::uint64_t seed = 0) {
+        splitmix64 sm(seed);
+        for (auto& word : s) word = sm();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const std::uint64_t result = detail::rotl(s[1] * 5, 7) * 9;
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = detail::rotl(s[3], 45);
+        return result;
+    }
+
+    // Advances the state by 2^128 draws, e.g. to split one seed into streams
+    void jump() {
+        constexpr std::uint64_t poly[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+                                          0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+        std::array<std::uint64_t, 4> acc{};
+        for (std::uint64_t word : poly) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (std::uint64_t{1} << b)) {
+                    for (int i = 0; i < 4; ++i) acc[i] ^= s[i];
+                }
+                (*this)();
+            }
+        }
+        s = acc;
+    }
+
+private:
+    std::array<std::uint64_t, 4> s;
+};
+
+class pcg32 {
+public:
+    using result_type = std::uint32_t;
+
+    explicit pcg32(std::uint64_t seed = 0, std::uint64_t stream = 0)
+        : inc((stream << 1) | 1) {
+        (*this)();
+        state += seed;
+        (*this)();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const std::uint64_t old = state;
+        state = old * 6364136223846793005ull + inc;
+        const auto xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        const auto rot = static_cast<std::uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+private:
+    std::uint64_t state = 0;
+    std::uint64_t inc;
+};
+
+/**
+ * N interleaved xoshiro256** generators for bulk generation; `next_block`
+ * produces N values with straight-line code over state arrays.
+ */
+template <std::size_t N>
+class xoshiro256ss_lanes {
+public:
+    template <class G>
+    explicit xoshiro256ss_lanes(G& seeder) {
+        for (std::size_t lane = 0; lane < N; ++lane) {
+            splitmix64 sm(seeder());
+            for (int i = 0; i < 4; ++i) s[i][lane] = sm();
+        }
+    }
+
+    void next_block(std::uint64_t* out) {
+        for (std::size_t l = 0; l < N; ++l) {
+            out[l] = detail::rotl(s[1][l] * 5, 7) * 9;
+            const std::uint64_t t = s[1][l] << 17;
+            s[2][l] ^= s[0][l];
+            s[3][l] ^= s[1][l];
+            s[1][l] ^= s[2][l];
+            s[0][l] ^= s[3][l];
+            s[2][l] ^= t;
+            s[3][l] = detail::rotl(s[3][l], 45);
+        }
+    }
+
+private:
+    alignas(cache_line_size) std::uint64_t s[4][N];
+};
+
+// [0, range) without modulo bias (Lemire, "Fast Random Integer Generation in an Interval")
+template <class G>
+std::uint32_t bounded(G& gen, std::uint32_t range) {
+    std::uint64_t m = std::uint64_t{static_cast<std::uint32_t>(gen())} * range;
+    auto low = static_cast<std::uint32_t>(m);
+    if (low < range) {
+        const std::uint32_t threshold = (0u - range) % range;
+        while (low < threshold) {
+            m = std::uint64_t{static_cast<std::uint32_t>(gen())} * range;
+            low = static_cast<std::uint32_t>(m);
+        }
+    }
+    return static_cast<std::uint32_t>(m >> 32);
+}
+
+template <class G>
+std::uint64_t bounded64(G& gen, std::uint64_t range) {
+    static_assert(G::max() == std::numeric_limits<std::uint64_t>::max(), "needs a 64-bit generator");
+    unsigned __int128 m = static_cast<unsigned __int128>(gen()) * range;
+    auto low = static_cast<std::uint64_t>(m);
+    if (low < range) {
+        const std::uint64_t threshold = (0ull - range) % range;
+        while (low < threshold) {
+            m = static_cast<unsigned __int128>(gen()) * range;
+            low = static_cast<std::uint64_t>(m);
+        }
+    }
+    return static_cast<std::uint64_t>(m >> 64);
+}
+
+// [0, 1) from the top bits of one draw
+template <class G>
+double uniform01(G& gen) {
+    if constexpr (G::max() == std::numeric_limits<std::uint64_t>::max()) {
+        return static_cast<double>(gen() >> 11) * 0x1.0p-53;
+    } else {
+        const std::uint64_t hi = gen(), lo = gen();
+        return static_cast<double>(((hi << 32) | lo) >> 11) * 0x1.0p-53;
+    }
+}
+
+// [0, 1) from the top 24 bits of one draw
+template <class G>
+float uniform01f(G& gen) {
+    if constexpr (G::max() == std::numeric_limits<std::uint64_t>::max()) {
+        return static_cast<float>(gen() >> 40) * 0x1.0p-24f;
+    } else {
+        return static_cast<float>(static_cast<std::uint32_t>(gen()) >> 8) * 0x1.0p-24f;
+    }
+}
+
+namespace detail {
+
+inline std::atomic<std::uint64_t> global_seed{0x853C49E6748FEA9Bull};
+inline std::atomic<std::uint64_t> next_thread_index{0};
+
+inline std::uint64_t thread_seed(std::uint64_t index) {
+    splitmix64 mix(global_seed.load(std::memory_order_relaxed) ^ (index * 0x9E3779B97F4A7C15ull));
+    return mix();
+}
+
+struct thread_rng_state {
+    xoshiro256ss gen{thread_seed(next_thread_index.fetch_add(1, std::memory_order_relaxed))};
+};
+
+inline thread_local thread_rng_state thread_rng_instance;
+
+} // namespace detail
+
+// Affects threads whose generator has not been used (or reseeded) yet
+inline void set_global_seed(std::uint64_t seed) {
+    detail::global_seed.store(seed, std::memory_order_relaxed);
+    detail::next_thread_index.store(0, std::memory_order_relaxed);
+}
+
+// Reseeds the calling thread's generator from the global seed and `index`
+inline void seed_thread_rng(std::uint64_t index) {
+    detail::thread_rng_instance.gen = xoshiro256ss(detail::thread_seed(index));
+}
+
+inline xoshiro256ss& thread_rng() { return detail::thread_rng_instance.gen; }
+
+// Drop-in for `rand() % n` without the global lock or the modulo bias
+inline std::uint32_t random_below(std::uint32_t n) { return bounded(thread_rng(), n); }
+
+// Fills `out` from eight vectorizable lanes seeded by the thread's generator
+inline void fill(std::span<std::uint64_t> out) {
+    constexpr std::size_t lanes = 8;
+    xoshiro256ss_lanes<lanes> gen(thread_rng());
+
+    std::size_t i = 0;
+    for (; i + lanes <= out.size(); i += lanes) gen.next_block(out.data() + i);
+    if (i < out.size()) {
+        std::uint64_t tail[lanes];
+        gen.next_block(tail);
+        for (std::size_t k = 0; i < out.size(); ++i, ++k) out[i] = tail[k];
+    }
+}
+
+inline void fill(std::span<double> out) {
+    constexpr std::size_t lanes = 8;
+    xoshiro256ss_lanes<lanes> gen(thread_rng());
+
+    std::uint64_t block[lanes];
+    for (std::size_t i = 0; i < out.size(); i += lanes) {
+        gen.next_block(block);
+        for (std::size_t k = 0; k < lanes && i + k < out.size(); ++k) {
+            out[i + k] = static_cast<double>(block[k] >> 11) * 0x1.0p-53;
+        }
+    }
+}
+
+} // namespace async
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * @brief Thin futex wrappers and a one-shot parked waiter.
+ *
+ * @details
+ * `std::atomic::wait` has no timeout, which rules it out for anything that
+ * must also honour a deadline. These helpers call futex(2) directly:
+ * - `futex_wait_until` sleeps while `*addr == expected`, up to an absolute
+ *   std::chrono::steady_clock deadline (FUTEX_WAIT_BITSET measures against
+ *   CLOCK_MONOTONIC, which is what steady_clock uses on Linux).
+ * - `futex_wake` wakes up to `n` sleepers.
+ *
+ * `parked_waiter` is a single 32-bit word that any number of event sources
+ * can `signal()`. Its owner re-arms it, re-checks its conditions and then
+ * parks on it; a signal that lands between the re-check and the park makes
+ * the futex call return immediately, so no wakeup is lost.
+ */
+
+namespace async::detail {
+
+inline void futex_wake(std::atomic<std::uint32_t>* addr, int n) {
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(addr), FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0);
+}
+
+// Returns false on timeout
+inline bool futex_wait_until(std::atomic<std::uint32_t>* addr, std::uint32_t expected,
+                             std::chrono::steady_clock::time_point deadline) {
+    const auto since_epoch = deadline.time_since_epoch();
+    const auto secs = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(secs.count());
+    ts.tv_nsec = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - secs).count());
+
+    const bool forever = deadline == std::chrono::steady_clock::time_point::max();
+    const long rc = ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(addr),
+                              FUTEX_WAIT_BITSET_PRIVATE, expected, forever ? nullptr : &ts, nullptr,
+                              FUTEX_BITSET_MATCH_ANY);
+    return !(rc == -1 && errno == ETIMEDOUT);
+}
+
+class parked_waiter {
+public:
+    void arm() { word.store(0, std::memory_order_seq_cst); }
+
+    void signal() {
+        if (word.exchange(1, std::memory_order_seq_cst) == 0) futex_wake(&word, INT_MAX);
+    }
+
+    bool signalled() const { return word.load(std::memory_order_acquire) != 0; }
+
+    // Parks until signalled or `deadline`; false on timeout
+    bool wait_until(std::chrono::steady_clock::time_point deadline) {
+        while (!signalled()) {
+            if (!futex_wait_until(&word, 0, deadline)) return false;
+        }
+        return true;
+    }
+
+private:
+    std::atomic<std::uint32_t> word{0};
+};
+
+} // namespace async::detail
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "fast_future.hpp"
+
+/**
+ * @brief `when_all` / `when_any` over fast_futures.
+ *
+ * @details
+ * Both combinators attach a continuation to every input (see
+ * `future_state::on_ready`) instead of parking a thread in `get()`:
+ *
+ * - `when_all` keeps the inputs in a shared block with one atomic counter.
+ *   Each continuation decrements it; the one that reaches zero collects the
+ *   values in input order (or the first exception, also in input order)
+ *   and fulfils the result.
+ * - `when_any` moves each input into its own continuation. The first one
+ *   to flip a single atomic flag fulfils the result with its index and
+ *   value; the others just drop theirs.
+ *
+ * Overloads take either a pack of heterogeneous futures (the result is a
+ * tuple / variant of their values, with std::monostate for void) or a
+ * vector of same-typed futures.
+ *
+ * @code
+ * auto both = async::when_all(async::spawn(pool, load_a), async::spawn(pool, load_b));
+ * auto [a, b] = both.get();
+ *
+ * auto first = async::when_any(std::move(replicas)).get();   // {index, value}
+ * @endcode
+ */
+
+namespace async {
+
+template <class T>
+using future_value_t = typename future_state<T>::value_type;
+
+template <class V>
+struct when_any_result {
+    std::size_t index;
+    V value;
+};
+
+namespace detail {
+
+template <class T>
+future_value_t<T> take_value(fast_future<T>& f) {
+    if constexpr (std::is_void_v<T>) {
+        f.get();
+        return {};
+    } else {
+        return f.get();
+    }
+}
+
+template <class T>
+void on_ready(fast_future<T>& f, task k) {
+    future_access::state(f)->on_ready(std::move(k));
+}
+
+} // namespace detail
+
+template <class T>
+fast_future<std::vector<future_value_t<T>>> when_all(std::vector<fast_future<T>> futures) {
+    using R = std::vector<future_value_t<T>>;
+
+    struct block {
+        std::vector<fast_future<T>> inputs;
+        std::atomic<std::size_t> remaining;
+        fast_promise<R> promise;
+
+        void finish() {
+            detail::fulfil(promise, [this] {
+                R values;
+                values.reserve(inputs.size());
+                for (auto& f : inputs) values.push_back(detail::take_value(f));
+                return values;
+            });
+        }
+    };
+
+    auto b = std::make_shared<block>();
+    b->inputs = std::move(futures);
+    b->remaining.store(b->inputs.size(), std::memory_order_relaxed);
+    fast_future<R> result = b->promise.get_future();
+
+    if (b->inputs.empty()) {
+        b->promise.set_value();
+        return result;
+    }
+    for (auto& f : b->inputs) {
+        detail::on_ready(f, task([b] {
+            if (b->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) b->finish();
+        }));
+    }
+    return result;
+}
+
+template <class... Ts>
+fast_future<std::tuple<future_value_t<Ts>...>> when_all(fast_future<Ts>... futures) {
+    using R = std::tuple<future_value_t<Ts>...>;
+
+    struct block {
+        std::tuple<fast_future<Ts>...> inputs;
+        std::atomic<std::size_t> remaining{sizeof...(Ts)};
+        fast_promise<R> promise;
+
+        void finish() {
+            detail::fulfil(promise, [this] {
+                // Braced init evaluates left to right: the first failure wins
+                return std::apply([](auto&... f) { return R{detail::take_value(f)...}; }, inputs);
+            });
+        }
+    };
+
+    auto b = std::make_shared<block>();
+    b->inputs = std::tuple<fast_future<Ts>...>(std::move(futures)...);
+    fast_future<R> result = b->promise.get_future();
+
+    if constexpr (sizeof...(Ts) == 0) {
+        b->promise.set_value();
+    } else {
+        std::apply([&b](auto&... f) {
+            (detail::on_ready(f, task([b] {
+                if (b->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) b->finish();
+            })), ...);
+        }, b->inputs);
+    }
+    return result;
+}
+
+// The result is broken_promise if `futures` is empty
+template <class T>
+fast_future<when_any_result<future_value_t<T>>> when_any(std::vector<fast_future<T>> futures) {
+    using R = when_any_result<future_value_t<T>>;
+
+    struct block {
+        std::atomic<bool> done{false};
+        fast_promise<R> promise;
+    };
+
+    auto b = std::make_shared<block>();
+    fast_future<R> result = b->promise.get_future();
+
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        auto* state = detail::future_access::state(futures[i]);
+        state->on_ready(task([b, i, f = std::move(futures[i])] () mutable {
+            if (b->done.exchange(true, std::memory_order_acq_rel)) return;
+            detail::fulfil(b->promise, [&] { return R{i, detail::take_value(f)}; });
+        }));
+    }
+    return result;
+}
+
+template <class... Ts>
+fast_future<when_any_result<std::variant<future_value_t<Ts>...>>> when_any(fast_future<Ts>... futures) {
+    using V = std::variant<future_value_t<Ts>...>;
+    using R = when_any_result<V>;
+
+    struct block {
+        std::atomic<bool> done{false};
+        fast_promise<R> promise;
+    };
+
+    auto b = std::make_shared<block>();
+    fast_future<R> result = b->promise.get_future();
+
+    auto attach = [&b]<std::size_t I, class T>(std::integral_constant<std::size_t, I>, fast_future<T>& f) {
+        auto* state = detail::future_access::state(f);
+        state->on_ready(task([b, f = std::move(f)] () mutable {
+            if (b->done.exchange(true, std::memory_order_acq_rel)) return;
+            detail::fulfil(b->promise, [&] { return R{I, V(std::in_place_index<I>, detail::take_value(f))}; });
+        }));
+    };
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        (attach(std::integral_constant<std::size_t, Is>{}, futures), ...);
+    }(std::index_sequence_for<Ts...>{});
+
+    return result;
+}
+
+} // namespace async
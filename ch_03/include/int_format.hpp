@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Batch integer-to-text formatting.
+ *
+ * @details
+ * Streaming each element through its own `std::osyncstream` temporary
+ * (as the original `printVector` did) costs one heap-allocated syncbuf,
+ * one lock and one locale-aware `operator<<` per int.
+ *
+ * `format_ints()` instead converts a whole `std::span<const int>` into a
+ * single `std::string`:
+ * - The buffer is sized once for the worst case (11 chars + separator).
+ * - Digits are emitted two at a time from a 200-byte digit-pair table,
+ *   writing each number back to front, so there is one division by 100
+ *   per two digits and no branches on individual digits.
+ *
+ * The caller then emits the whole buffer with a single `sync_cout <<`,
+ * which is one atomic write.
+ *
+ * `format_ints_parallel()` splits very large spans into contiguous chunks,
+ * formats each chunk on its own thread and concatenates the pieces in
+ * order, so the output is byte-identical to `format_ints()`.
+ */
+
+namespace async {
+
+namespace detail {
+
+inline constexpr char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+inline int count_digits(std::uint32_t v) {
+    if (v < 10) return 1;
+    if (v < 100) return 2;
+    if (v < 1000) return 3;
+    if (v < 10000) return 4;
+    if (v < 100000) return 5;
+    if (v < 1000000) return 6;
+    if (v < 10000000) return 7;
+    if (v < 100000000) return 8;
+    if (v < 1000000000) return 9;
+    return 10;
+}
+
+// Writes `value` at `out` and returns one past the last character written.
+inline char* write_int(char* out, int value) {
+    std::uint32_t v = static_cast<std::uint32_t>(value);
+    if (value < 0) {
+        *out++ = '-';
+        v = 0u - v;
+    }
+
+    const int len = count_digits(v);
+    char* p = out + len;
+    while (v >= 100) {
+        const std::uint32_t pair = (v % 100) * 2;
+        v /= 100;
+        p -= 2;
+        std::memcpy(p, digit_pairs + pair, 2);
+    }
+    if (v >= 10) {
+        std::memcpy(p - 2, digit_pairs + v * 2, 2);
+    } else {
+        *(p - 1) = static_cast<char>('0' + v);
+    }
+    return out + len;
+}
+
+// Formats `values` into `out`; every element is followed by `sep`.
+inline char* write_ints(char* out, std::span<const int> values, char sep) {
+    for (int v : values) {
+        out = write_int(out, v);
+        *out++ = sep;
+    }
+    return out;
+}
+
+inline constexpr std::size_t max_int_chars = 11;   // "-2147483648"
+
+} // namespace detail
+
+/**
+ * Formats `values` as text, each element followed by `sep`.
+ */
+inline std::string format_ints(std::span<const int> values, char sep = ' ') {
+    std::string out(values.size() * (detail::max_int_chars + 1), '\0');
+    char* end = detail::write_ints(out.data(), values, sep);
+    out.resize(static_cast<std::size_t>(end - out.data()));
+    return out;
+}
+
+/**
+ * Below this many elements per thread, splitting is slower than formatting
+ * on the calling thread.
+ */
+inline constexpr std::size_t parallel_format_min_chunk = 1 << 18;
+
+/**
+ * Formats `values` like `format_ints()`, splitting the span across up to
+ * `max_threads` threads (0 = hardware_concurrency) when it is large enough.
+ */
+inline std::string format_ints_parallel(std::span<const int> values, char sep = ' ',
+                                        unsigned max_threads = 0) {
+    if (max_threads == 0) max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    const std::size_t by_size = values.size() / parallel_format_min_chunk;
+    const std::size_t n_chunks = std::min<std::size_t>(max_threads, by_size);
+    if (n_chunks <= 1) return format_ints(values, sep);
+
+    const std::size_t chunk = (values.size() + n_chunks - 1) / n_chunks;
+    std::vector<std::string> parts(n_chunks);
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(n_chunks - 1);
+        for (std::size_t i = 1; i < n_chunks; ++i) {
+            auto sub = values.subspan(i * chunk, std::min(chunk, values.size() - i * chunk));
+            workers.emplace_back([&parts, i, sub, sep] { parts[i] = format_ints(sub, sep); });
+        }
+        parts[0] = format_ints(values.first(chunk), sep);
+    }   // jthreads join here
+
+    std::size_t total = 0;
+    for (const auto& p : parts) total += p.size();
+
+    std::string out;
+    out.reserve(total);
+    for (const auto& p : parts) out += p;
+    return out;
+}
+
+} // namespace async
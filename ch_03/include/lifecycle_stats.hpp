@@ -0,0 +1,294 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Opt-in thread lifecycle latency histograms.
+ *
+ * @details
+ * Three phases are recorded per thread name:
+ * - start latency: thread object constructed -> first instruction of its function
+ * - run time:      first instruction -> function returned
+ * - join wait:     how long the owner's join() blocked
+ *
+ * `latency_histogram` is HDR-style log-linear: 16 linear sub-buckets per
+ * power of two (at most ~6% error) over the full 64-bit nanosecond range,
+ * 976 relaxed atomic counters. Recording is one bit scan and a few relaxed
+ * fetch_adds; no locks, no allocation.
+ *
+ * Everything is off by default. `lifecycle_stats_for(name)` returns nullptr
+ * until `enable_lifecycle_stats()` was called, and `instrument_thread()` /
+ * `join_timer` do nothing for a null pointer, so a disabled build pays one
+ * relaxed load per thread construction. Looking up a name takes a mutex
+ * once per thread construction, never on the recording path.
+ *
+ * `enable_lifecycle_stats(format)` can register an at-exit report (text or
+ * JSON, to stderr); `enable_lifecycle_stats_from_env()` does so when
+ * ASYNC_LIFECYCLE_STATS is set to "text" or "json".
+ *
+ * @code
+ * auto* stats = async::lifecycle_stats_for("worker");
+ * std::jthread t(async::instrument_thread(stats, [] { work(); }));
+ * {
+ *     async::join_timer timing(stats);
+ *     t.join();
+ * }
+ * @endcode
+ */
+
+namespace async {
+
+class latency_histogram {
+public:
+    static constexpr int sub_bits = 4;
+    static constexpr std::size_t sub_buckets = std::size_t{1} << sub_bits;
+    static constexpr std::size_t bucket_count = (64 - sub_bits + 1) * sub_buckets;
+
+    void record(std::chrono::nanoseconds d) {
+        const std::uint64_t v = d.count() > 0 ? static_cast<std::uint64_t>(d.count()) : 0;
+        counts[index(v)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(v, std::memory_order_relaxed);
+        for (auto m = largest.load(std::memory_order_relaxed);
+             v > m && !largest.compare_exchange_weak(m, v, std::memory_order_relaxed);) {}
+    }
+
+    std::uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    std::chrono::nanoseconds max() const { return as_ns(largest.load(std::memory_order_relaxed)); }
+
+    std::chrono::nanoseconds mean() const {
+        const auto n = count();
+        return n ? as_ns(sum.load(std::memory_order_relaxed) / n) : std::chrono::nanoseconds(0);
+    }
+
+    // Highest value equivalent to the p-th percentile (p in [0, 100])
+    std::chrono::nanoseconds percentile(double p) const {
+        const auto n = count();
+        if (n == 0) return std::chrono::nanoseconds(0);
+        const auto target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(n) + 0.5));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            seen += counts[i].load(std::memory_order_relaxed);
+            if (seen >= target) {
+                const std::uint64_t upper = i + 1 < bucket_count ? lower_bound(i + 1) - 1 : ~std::uint64_t{0};
+                return as_ns(std::min(upper, largest.load(std::memory_order_relaxed)));
+            }
+        }
+        return max();
+    }
+
+private:
+    static std::size_t index(std::uint64_t v) {
+        if (v < sub_buckets) return static_cast<std::size_t>(v);
+        const int shift = (63 - std::countl_zero(v)) - sub_bits;
+        return static_cast<std::size_t>(shift + 1) * sub_buckets + static_cast<std::size_t>((v >> shift) & (sub_buckets - 1));
+    }
+
+    static std::uint64_t lower_bound(std::size_t i) {
+        if (i < sub_buckets) return i;
+        const std::size_t shift = i / sub_buckets - 1;
+        return (sub_buckets + i % sub_buckets) << shift;
+    }
+
+    static std::chrono::nanoseconds as_ns(std::uint64_t v) {
+        return std::chrono::nanoseconds(static_cast<std::int64_t>(std::min<std::uint64_t>(v, INT64_MAX)));
+    }
+
+    std::array<std::atomic<std::uint64_t>, bucket_count> counts{};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> largest{0};
+};
+
+struct lifecycle_stats {
+    latency_histogram start_latency;
+    latency_histogram run_time;
+    latency_histogram join_wait;
+};
+
+enum class report_format { none, text, json };
+
+namespace detail {
+
+struct lifecycle_entry {
+    std::string name;
+    lifecycle_stats stats;
+};
+
+struct lifecycle_registry {
+    std::mutex mtx;
+    std::vector<std::unique_ptr<lifecycle_entry>> entries;   // never shrinks: pointers stay valid
+    report_format at_exit = report_format::none;
+};
+
+inline std::atomic<bool> lifecycle_enabled{false};
+
+inline lifecycle_registry& lifecycle_state() {
+    static lifecycle_registry registry;
+    return registry;
+}
+
+inline void json_string(std::ostream& os, std::string_view s) {
+    os << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof buf, "\\u%04x", c);
+            os << buf;
+        } else {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+inline void json_histogram(std::ostream& os, const latency_histogram& h) {
+    os << "{\"count\":" << h.count() << ",\"mean\":" << h.mean().count() << ",\"p50\":" << h.percentile(50).count()
+       << ",\"p90\":" << h.percentile(90).count() << ",\"p99\":" << h.percentile(99).count()
+       << ",\"max\":" << h.max().count() << '}';
+}
+
+} // namespace detail
+
+inline void write_lifecycle_report(std::ostream& os, report_format format) {
+    auto& state = detail::lifecycle_state();
+    std::lock_guard<std::mutex> lock(state.mtx);
+
+    if (format == report_format::json) {
+        os << "{\"threads\":[";
+        for (std::size_t i = 0; i < state.entries.size(); ++i) {
+            const auto& e = *state.entries[i];
+            os << (i ? "," : "") << "{\"name\":";
+            detail::json_string(os, e.name);
+            os << ",\"start_latency_ns\":";
+            detail::json_histogram(os, e.stats.start_latency);
+            os << ",\"run_time_ns\":";
+            detail::json_histogram(os, e.stats.run_time);
+            os << ",\"join_wait_ns\":";
+            detail::json_histogram(os, e.stats.join_wait);
+            os << '}';
+        }
+        os << "]}\n";
+        return;
+    }
+    if (format != report_format::text) return;
+
+    auto us = [](std::chrono::nanoseconds ns) { return std::chrono::duration<double, std::micro>(ns).count(); };
+    char line[160];
+    os << "thread lifecycle (us)            count       p50       p90       p99       max\n";
+    for (const auto& e : state.entries) {
+        const std::pair<const char*, const latency_histogram*> phases[] = {
+            {"start", &e->stats.start_latency}, {"run", &e->stats.run_time}, {"join", &e->stats.join_wait}};
+        for (const auto& [phase, h] : phases) {
+            std::snprintf(line, sizeof line, "  %-16.16s %-6s %9llu %9.1f %9.1f %9.1f %9.1f\n", e->name.c_str(), phase,
+                          static_cast<unsigned long long>(h->count()), us(h->percentile(50)), us(h->percentile(90)),
+                          us(h->percentile(99)), us(h->max()));
+            os << line;
+        }
+    }
+}
+
+namespace detail {
+
+inline void report_at_exit() {
+    write_lifecycle_report(std::cerr, lifecycle_state().at_exit);
+}
+
+} // namespace detail
+
+inline void enable_lifecycle_stats(report_format at_exit = report_format::none) {
+    auto& state = detail::lifecycle_state();   // constructed before the handler is registered
+    {
+        std::lock_guard<std::mutex> lock(state.mtx);
+        if (at_exit != report_format::none && state.at_exit == report_format::none) std::atexit(detail::report_at_exit);
+        if (at_exit != report_format::none) state.at_exit = at_exit;
+    }
+    detail::lifecycle_enabled.store(true, std::memory_order_release);
+}
+
+// ASYNC_LIFECYCLE_STATS=text|json enables recording and the matching at-exit report;
+// any other value (unset, empty, "0", "off", ...) leaves it disabled
+inline bool enable_lifecycle_stats_from_env() {
+    const char* v = std::getenv("ASYNC_LIFECYCLE_STATS");
+    if (!v) return false;
+    if (std::strcmp(v, "text") == 0) {
+        enable_lifecycle_stats(report_format::text);
+    } else if (std::strcmp(v, "json") == 0) {
+        enable_lifecycle_stats(report_format::json);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Stats for threads called `name`, or nullptr while recording is disabled
+inline lifecycle_stats* lifecycle_stats_for(std::string_view name) {
+    if (!detail::lifecycle_enabled.load(std::memory_order_relaxed)) return nullptr;
+    auto& state = detail::lifecycle_state();
+    std::lock_guard<std::mutex> lock(state.mtx);
+    for (auto& e : state.entries) {
+        if (e->name == name) return &e->stats;
+    }
+    state.entries.push_back(std::make_unique<detail::lifecycle_entry>());
+    state.entries.back()->name = std::string(name);
+    return &state.entries.back()->stats;
+}
+
+// Wraps a thread function so it records start latency (from this call) and run time
+template <class F>
+auto instrument_thread(lifecycle_stats* stats, F&& fn) {
+    using clock = std::chrono::steady_clock;
+    const auto created = stats ? clock::now() : clock::time_point{};
+    // Constrained so std::jthread's "does it take a stop_token?" probe sees the real signature
+    return [stats, created, fn = std::forward<F>(fn)](auto&&... args) mutable
+               requires std::is_invocable_v<std::decay_t<F>&, decltype(args)...> {
+        if (!stats) {
+            fn(std::forward<decltype(args)>(args)...);
+            return;
+        }
+        const auto started = clock::now();
+        stats->start_latency.record(started - created);
+        fn(std::forward<decltype(args)>(args)...);
+        stats->run_time.record(clock::now() - started);
+    };
+}
+
+// Records how long the enclosing scope (a join) blocked
+class join_timer {
+public:
+    explicit join_timer(lifecycle_stats* s)
+        : stats(s), start(s ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}) {}
+
+    ~join_timer() {
+        if (stats) stats->join_wait.record(std::chrono::steady_clock::now() - start);
+    }
+
+    join_timer(const join_timer&) = delete;
+    join_timer& operator=(const join_timer&) = delete;
+
+private:
+    lifecycle_stats* stats;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace async
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "thread_pool.hpp"
+#include "timer_wheel.hpp"
+
+/**
+ * @brief Periodic jobs sharing one scheduler thread.
+ *
+ * @details
+ * `daemonThread()` in 07_daemon_threads.cpp runs
+ * `while (...) { work(); sleep_for(1s); }`, so every period is stretched
+ * by the time `work()` takes and each job needs its own thread.
+ * `periodic_scheduler::schedule_every(period, fn, options)` keeps any
+ * number of jobs on one `timer_wheel` driver thread.
+ *
+ * Modes:
+ * - `periodic_mode::fixed_rate`:  run k is due at `first + k * period`,
+ *   computed from steady_clock, so neither work time nor wake-up latency
+ *   accumulates into drift.
+ * - `periodic_mode::fixed_delay`: the next run is due `period` after the
+ *   previous one returned (the sleep_for loop, minus its thread).
+ *
+ * A job never overlaps itself: the next run is armed when the current one
+ * returns. If a fixed-rate run overruns one or more later slots, the
+ * `missed_tick_policy` decides what happens to them:
+ * - `skip`:     drop them and resume at the next slot still in the future
+ * - `catch_up`: run every missed slot, back to back
+ * - `coalesce`: run once now for all of them, then resume on schedule
+ *
+ * `fn` is invoked as `fn(const periodic_tick&)` if it accepts that, else
+ * as `fn()`. The tick tells it which slot it runs for and how many slots
+ * were dropped just before it. Jobs run inline on the driver thread (keep
+ * them short) or on `pool` if one is given; fn must not throw.
+ *
+ * `periodic_handle::cancel()` stops future runs in O(1); a run already in
+ * progress completes. Handles may outlive the scheduler. The scheduler's
+ * destructor waits for runs in progress and drops everything else.
+ *
+ * @code
+ * async::periodic_scheduler scheduler;
+ * auto heartbeat = scheduler.schedule_every(1s, [] { sync_cout << "alive\n"; });
+ * auto flush = scheduler.schedule_every(100ms, [&](const async::periodic_tick& t) {
+ *     if (t.missed) sync_cout << "flush skipped " << t.missed << " slots\n";
+ *     flush_buffers();
+ * });
+ * heartbeat.cancel();
+ * @endcode
+ */
+
+namespace async {
+
+enum class periodic_mode { fixed_rate, fixed_delay };
+
+enum class missed_tick_policy { skip, catch_up, coalesce };
+
+struct periodic_options {
+    periodic_mode mode = periodic_mode::fixed_rate;
+    missed_tick_policy missed = missed_tick_policy::skip;
+    bool run_immediately = false;   // first run now instead of one period from now
+};
+
+struct periodic_tick {
+    std::chrono::steady_clock::time_point scheduled;
+    std::uint64_t index;    // slot number, counted from the first run
+    std::uint64_t missed;   // slots dropped (skip) or folded in (coalesce) before this run
+};
+
+namespace detail {
+
+// Shared by the scheduler and every job so handles can outlive the scheduler
+struct periodic_link {
+    std::mutex mtx;
+    timer_wheel* wheel;
+};
+
+struct periodic_job {
+    using clock = std::chrono::steady_clock;
+
+    periodic_job(clock::duration p, periodic_options o, std::shared_ptr<periodic_link> l)
+        : period(p), options(o), link(std::move(l)) {}
+    virtual ~periodic_job() = default;
+    virtual void invoke(const periodic_tick& tick) = 0;
+
+    const clock::duration period;
+    const periodic_options options;
+    const std::shared_ptr<periodic_link> link;
+
+    std::mutex mtx;   // guards everything below
+    bool cancelled = false;
+    timer_wheel::timer_id timer = timer_wheel::invalid_timer;
+    periodic_tick next{};
+
+    std::atomic<std::uint64_t> runs{0};
+    std::atomic<std::uint64_t> missed{0};
+};
+
+template <class F>
+struct periodic_job_model final : periodic_job {
+    periodic_job_model(clock::duration p, periodic_options o, std::shared_ptr<periodic_link> l, F f)
+        : periodic_job(p, o, std::move(l)), fn(std::move(f)) {}
+
+    void invoke(const periodic_tick& tick) override {
+        if constexpr (std::is_invocable_v<F&, const periodic_tick&>) {
+            fn(tick);
+        } else {
+            fn();
+        }
+    }
+
+    F fn;
+};
+
+} // namespace detail
+
+class periodic_handle {
+public:
+    periodic_handle() = default;
+
+    // False if already cancelled (or empty)
+    bool cancel() {
+        if (!job) return false;
+        timer_wheel::timer_id timer;
+        {
+            std::lock_guard<std::mutex> lock(job->mtx);
+            if (job->cancelled) return false;
+            job->cancelled = true;
+            timer = std::exchange(job->timer, timer_wheel::invalid_timer);
+        }
+        std::lock_guard<std::mutex> lock(job->link->mtx);
+        if (job->link->wheel) job->link->wheel->cancel(timer);
+        return true;
+    }
+
+    bool active() const {
+        if (!job) return false;
+        std::lock_guard<std::mutex> lock(job->mtx);
+        return !job->cancelled;
+    }
+
+    std::uint64_t runs() const { return job ? job->runs.load(std::memory_order_relaxed) : 0; }
+    std::uint64_t missed() const { return job ? job->missed.load(std::memory_order_relaxed) : 0; }
+
+private:
+    friend class periodic_scheduler;
+    explicit periodic_handle(std::shared_ptr<detail::periodic_job> j) : job(std::move(j)) {}
+
+    std::shared_ptr<detail::periodic_job> job;
+};
+
+class periodic_scheduler {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit periodic_scheduler(thread_pool* pool = nullptr,
+                                std::chrono::microseconds resolution = std::chrono::milliseconds(1))
+        : executor(pool), link(std::make_shared<detail::periodic_link>()), wheel(resolution) {
+        link->wheel = &wheel;
+    }
+
+    ~periodic_scheduler() {
+        {
+            std::lock_guard<std::mutex> lock(link->mtx);
+            link->wheel = nullptr;
+        }
+        std::unique_lock<std::mutex> lock(mtx);
+        stopping = true;
+        idle_cv.wait(lock, [&] { return in_flight == 0; });
+    }
+
+    periodic_scheduler(const periodic_scheduler&) = delete;
+    periodic_scheduler& operator=(const periodic_scheduler&) = delete;
+
+    // Throws std::invalid_argument unless `period` is positive
+    template <class Rep, class Period, class F>
+    periodic_handle schedule_every(std::chrono::duration<Rep, Period> period, F&& fn,
+                                   periodic_options options = {}) {
+        const auto p = std::chrono::duration_cast<clock::duration>(period);
+        if (p <= clock::duration::zero()) throw std::invalid_argument("periodic_scheduler: period must be positive");
+        auto job = std::make_shared<detail::periodic_job_model<std::decay_t<F>>>(
+            p, options, link, std::forward<F>(fn));
+
+        {
+            std::lock_guard<std::mutex> lock(job->mtx);
+            job->next = {clock::now() + (options.run_immediately ? clock::duration::zero() : p), 0, 0};
+            arm(job);
+        }
+        return periodic_handle(std::move(job));
+    }
+
+private:
+    // Caller holds job->mtx
+    void arm(const std::shared_ptr<detail::periodic_job>& job) {
+        job->timer = wheel.schedule_at(job->next.scheduled, [this, job] { fire(job); });
+    }
+
+    void fire(std::shared_ptr<detail::periodic_job> job) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (stopping) return;
+            ++in_flight;
+        }
+        if (executor) {
+            executor->submit([this, job = std::move(job)] { run(*job, job); });
+        } else {
+            run(*job, job);
+        }
+    }
+
+    void run(detail::periodic_job& job, const std::shared_ptr<detail::periodic_job>& owner) {
+        periodic_tick tick;
+        bool live;
+        {
+            std::lock_guard<std::mutex> lock(job.mtx);
+            live = !job.cancelled;
+            tick = job.next;
+        }
+
+        if (live) {
+            job.invoke(tick);
+            job.runs.fetch_add(1, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(job.mtx);
+            if (!job.cancelled) {
+                job.next = next_tick(job, tick);
+                if (job.next.missed) job.missed.fetch_add(job.next.missed, std::memory_order_relaxed);
+                arm(owner);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mtx);
+        if (--in_flight == 0 && stopping) idle_cv.notify_all();
+    }
+
+    static periodic_tick next_tick(const detail::periodic_job& job, const periodic_tick& done) {
+        const auto now = clock::now();
+        if (job.options.mode == periodic_mode::fixed_delay) return {now + job.period, done.index + 1, 0};
+
+        periodic_tick next{done.scheduled + job.period, done.index + 1, 0};
+        if (next.scheduled > now || job.options.missed == missed_tick_policy::catch_up) return next;
+
+        // Slots next.scheduled, +period, ... up to now have all passed
+        const auto overdue = static_cast<std::uint64_t>((now - next.scheduled) / job.period) + 1;
+        if (job.options.missed == missed_tick_policy::skip) {
+            next.scheduled += job.period * static_cast<clock::rep>(overdue);
+            next.index += overdue;
+            next.missed = overdue;
+        } else {   // coalesce: one run now stands in for the latest overdue slot
+            next.scheduled += job.period * static_cast<clock::rep>(overdue - 1);
+            next.index += overdue - 1;
+            next.missed = overdue - 1;
+        }
+        return next;
+    }
+
+    thread_pool* const executor;
+    const std::shared_ptr<detail::periodic_link> link;
+
+    std::mutex mtx;
+    std::condition_variable idle_cv;
+    std::size_t in_flight = 0;
+    bool stopping = false;
+
+    timer_wheel wheel;   // last: its driver stops before the members above go away
+};
+
+} // namespace async
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+
+#include <sys/prctl.h>
+
+#include "cpu_relax.hpp"
+
+/**
+ * @brief Sub-millisecond sleeps: coarse kernel sleep plus a short spin.
+ *
+ * @details
+ * `std::this_thread::sleep_for` wakes up late by the thread's timer slack
+ * (50us by default for normal threads) plus scheduler latency, so a 100us
+ * sleep commonly takes 150-200us. A pure busy loop (10_yield_thread.cpp)
+ * is precise but burns a whole core for the full duration.
+ *
+ * `precise_sleep_until(deadline)`:
+ * 1. sleeps with `clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME)` until
+ *    `deadline - margin` (absolute, so signals and restarts do not add
+ *    error);
+ * 2. spins with `cpu_relax()` for the remaining few microseconds.
+ *
+ * `margin` is learned per thread: every kernel sleep measures how late it
+ * woke up, and the margin tracks that overshoot's moving mean plus three
+ * times its mean deviation (the TCP RTO estimator), clamped to
+ * [min_spin, max_spin]. A quiet machine converges to a margin of a few
+ * microseconds; a noisy one spins longer rather than wake late. Single
+ * outliers are capped, and a wait too short to sleep at all decays the
+ * margin, so one preemption cannot leave the thread spinning forever.
+ *
+ * On its first call in a thread it lowers that thread's timer slack to
+ * 1ns with `prctl(PR_SET_TIMERSLACK)` unless `set_timer_slack()` was called
+ * before. The slack is a per-thread attribute inherited by threads it
+ * creates.
+ *
+ * @code
+ * auto next = std::chrono::steady_clock::now();
+ * for (;;) {
+ *     next += 250us;
+ *     async::precise_sleep_until(next);
+ *     sample();
+ * }
+ * @endcode
+ */
+
+namespace async {
+
+namespace detail {
+
+struct precise_sleep_state {
+    bool slack_set = false;
+    double mean_ns = 50'000.0;   // conservative until the first samples arrive
+    double dev_ns = 0.0;
+};
+
+inline thread_local precise_sleep_state precise_sleep_tls;
+
+inline constexpr double min_spin_ns = 2'000.0;
+inline constexpr double max_spin_ns = 2'000'000.0;
+
+inline timespec to_timespec(std::chrono::steady_clock::time_point tp) {
+    const auto since_epoch = tp.time_since_epoch();
+    const auto secs = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(secs.count());
+    ts.tv_nsec = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - secs).count());
+    return ts;
+}
+
+} // namespace detail
+
+// Timer slack of the calling thread; 0 restores the process default
+inline bool set_timer_slack(std::chrono::nanoseconds slack) {
+    detail::precise_sleep_tls.slack_set = true;
+    return ::prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(slack.count()), 0, 0, 0) == 0;
+}
+
+// Spin margin currently learned by the calling thread
+inline std::chrono::nanoseconds sleep_overshoot_estimate() {
+    const auto& s = detail::precise_sleep_tls;
+    const double margin = std::clamp(s.mean_ns + 3.0 * s.dev_ns, detail::min_spin_ns, detail::max_spin_ns);
+    return std::chrono::nanoseconds(static_cast<std::int64_t>(margin));
+}
+
+inline void precise_sleep_until(std::chrono::steady_clock::time_point deadline) {
+    using clock = std::chrono::steady_clock;
+    auto& s = detail::precise_sleep_tls;
+    if (!s.slack_set) set_timer_slack(std::chrono::nanoseconds(1));
+
+    const auto margin = sleep_overshoot_estimate();
+    const auto wake_at = deadline - margin;
+    if (clock::now() < wake_at) {
+        const timespec ts = detail::to_timespec(wake_at);
+        while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+
+        // A preemption can make one wake-up milliseconds late; cap its weight
+        double overshoot = std::chrono::duration<double, std::nano>(clock::now() - wake_at).count();
+        overshoot = std::min(overshoot, 4.0 * static_cast<double>(margin.count()));
+        const double err = overshoot - s.mean_ns;
+        s.mean_ns += err / 8.0;
+        s.dev_ns += (std::abs(err) - s.dev_ns) / 4.0;
+    } else {
+        // Pure spin yields no sample; shrink the margin so a spike is not permanent
+        s.mean_ns *= 0.875;
+        s.dev_ns *= 0.875;
+    }
+
+    while (clock::now() < deadline) cpu_relax();
+}
+
+template <class Rep, class Period>
+void precise_sleep_for(std::chrono::duration<Rep, Period> d) {
+    precise_sleep_until(std::chrono::steady_clock::now() + d);
+}
+
+} // namespace async
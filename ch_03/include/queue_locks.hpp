@@ -0,0 +1,245 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#include "cache_line.hpp"
+#include "cpu_relax.hpp"
+
+/**
+ * @brief FIFO locks: ticket, MCS and CLH.
+ *
+ * @details
+ * `std::mutex` and `spinlock` (spinlock.hpp) hand the lock to whichever
+ * thread gets there first, often the one that just released it, so under
+ * heavy contention some threads starve. These three grant it strictly in
+ * arrival order:
+ *
+ * - `ticket_lock`: `lock()` takes a number with one fetch_add and waits
+ *   until `serving` reaches it; `unlock()` increments `serving`. Two
+ *   words on separate cache lines. Every waiter polls the same `serving`
+ *   line, so each hand-off invalidates it in all waiters' caches; waiters
+ *   back off in proportion to their distance from the head of the queue.
+ * - `mcs_lock`: waiters form a linked queue through `tail`; each spins on
+ *   the `locked` flag of its own node, and the releasing thread clears
+ *   exactly its successor's flag. One cache-line transfer per hand-off,
+ *   whatever the number of waiters.
+ * - `clh_lock`: each waiter spins on its predecessor's node instead and
+ *   releases by clearing its own; nodes migrate between threads (the
+ *   releaser takes over its predecessor's node). Unlock needs no CAS.
+ *
+ * `ticket_lock` and `mcs_lock` are Lockable; `clh_lock` is BasicLockable
+ * only, since a CLH waiter cannot leave the queue once it has swapped
+ * itself into `tail` (std::lock_guard and std::unique_lock still work).
+ *
+ * Queue nodes come from a small per-thread cache (heap-allocated,
+ * cache-line-aligned, freed at thread exit), so `lock()`/`unlock()` need
+ * no arguments and locks may nest or be released out of order.
+ * `mcs_lock::lock(node)` also accepts a caller-provided node, e.g. on the
+ * stack.
+ *
+ * A FIFO lock cannot skip a waiter: if the next thread in line is not
+ * running, nobody gets the lock. Waiters therefore yield once they have
+ * spent `yield_after_pauses` pauses (a few microseconds), which matters
+ * once threads outnumber cores.
+ *
+ * @code
+ * async::mcs_lock lock;
+ * {
+ *     std::lock_guard<async::mcs_lock> guard(lock);
+ *     ++counter;
+ * }
+ * @endcode
+ */
+
+namespace async {
+
+namespace detail {
+
+inline constexpr std::uint32_t yield_after_pauses = 256;
+
+// Pauses, then yields once `yield_after_pauses` pauses have been spent
+class spin_waiter {
+public:
+    void wait(std::uint32_t pauses = 1) noexcept {
+        if (spent >= yield_after_pauses) {
+            std::this_thread::yield();
+            return;
+        }
+        spent += pauses;
+        for (; pauses > 0; --pauses) cpu_relax();
+    }
+
+private:
+    std::uint32_t spent = 0;
+};
+
+struct alignas(cache_line_size) queue_node {
+    std::atomic<queue_node*> next{nullptr};
+    std::atomic<bool> locked{false};
+    queue_node* free_next = nullptr;   // only while cached
+};
+
+class node_cache {
+public:
+    ~node_cache() {
+        while (head) delete std::exchange(head, head->free_next);
+    }
+
+    queue_node* acquire() { return head ? std::exchange(head, head->free_next) : new queue_node; }
+
+    void release(queue_node* n) noexcept {
+        n->free_next = head;
+        head = n;
+    }
+
+private:
+    queue_node* head = nullptr;
+};
+
+inline thread_local node_cache queue_nodes;
+
+} // namespace detail
+
+class ticket_lock {
+public:
+    ticket_lock() = default;
+    ticket_lock(const ticket_lock&) = delete;
+    ticket_lock& operator=(const ticket_lock&) = delete;
+
+    void lock() noexcept {
+        const std::uint32_t ticket = next.value.fetch_add(1, std::memory_order_relaxed);
+        detail::spin_waiter waiter;
+        while (true) {
+            const std::uint32_t now = serving.value.load(std::memory_order_acquire);
+            if (now == ticket) return;
+            // Proportional backoff: the further back in line, the longer the pause
+            waiter.wait((ticket - now) * backoff_per_waiter);
+        }
+    }
+
+    bool try_lock() noexcept {
+        std::uint32_t now = serving.value.load(std::memory_order_acquire);
+        std::uint32_t expected = now;
+        return next.value.compare_exchange_strong(expected, now + 1, std::memory_order_acquire,
+                                                  std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept {
+        // Only the holder writes `serving`
+        serving.value.store(serving.value.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    static constexpr std::uint32_t backoff_per_waiter = 8;
+
+    struct alignas(cache_line_size) counter {
+        std::atomic<std::uint32_t> value{0};
+    };
+
+    counter next;
+    counter serving;
+};
+
+class mcs_lock {
+public:
+    using node = detail::queue_node;
+
+    mcs_lock() = default;
+    mcs_lock(const mcs_lock&) = delete;
+    mcs_lock& operator=(const mcs_lock&) = delete;
+
+    void lock() {
+        node* n = detail::queue_nodes.acquire();
+        lock(*n);
+        holder = n;
+    }
+
+    bool try_lock() {
+        node* n = detail::queue_nodes.acquire();
+        n->next.store(nullptr, std::memory_order_relaxed);
+        node* expected = nullptr;
+        if (tail.compare_exchange_strong(expected, n, std::memory_order_acquire, std::memory_order_relaxed)) {
+            holder = n;
+            return true;
+        }
+        detail::queue_nodes.release(n);
+        return false;
+    }
+
+    void unlock() noexcept {
+        node* n = holder;
+        unlock(*n);
+        detail::queue_nodes.release(n);
+    }
+
+    // `n` must stay alive and untouched until the matching unlock(n)
+    void lock(node& n) noexcept {
+        n.next.store(nullptr, std::memory_order_relaxed);
+        n.locked.store(true, std::memory_order_relaxed);
+        node* prev = tail.exchange(&n, std::memory_order_acq_rel);
+        if (!prev) return;
+        prev->next.store(&n, std::memory_order_release);
+        detail::spin_waiter waiter;
+        while (n.locked.load(std::memory_order_acquire)) waiter.wait();
+    }
+
+    void unlock(node& n) noexcept {
+        node* succ = n.next.load(std::memory_order_acquire);
+        if (!succ) {
+            node* expected = &n;
+            if (tail.compare_exchange_strong(expected, nullptr, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+                return;
+            }
+            // A successor swapped itself in but has not linked yet
+            detail::spin_waiter waiter;
+            while (!(succ = n.next.load(std::memory_order_acquire))) waiter.wait();
+        }
+        succ->locked.store(false, std::memory_order_release);
+    }
+
+private:
+    alignas(cache_line_size) std::atomic<node*> tail{nullptr};
+    // Written and read by the holder only; kept off the line every
+    // arriving thread swaps `tail` on
+    alignas(cache_line_size) node* holder = nullptr;
+};
+
+class clh_lock {
+public:
+    using node = detail::queue_node;
+
+    clh_lock() : tail(new node) {}   // an unlocked dummy: the first waiter's predecessor
+
+    ~clh_lock() { delete tail.load(std::memory_order_relaxed); }
+
+    clh_lock(const clh_lock&) = delete;
+    clh_lock& operator=(const clh_lock&) = delete;
+
+    void lock() {
+        node* n = detail::queue_nodes.acquire();
+        n->locked.store(true, std::memory_order_relaxed);
+        node* pred = tail.exchange(n, std::memory_order_acq_rel);
+        detail::spin_waiter waiter;
+        while (pred->locked.load(std::memory_order_acquire)) waiter.wait();
+        holder = n;
+        holder_pred = pred;
+    }
+
+    void unlock() noexcept {
+        node* pred = holder_pred;
+        holder->locked.store(false, std::memory_order_release);   // now owned by the successor (or tail)
+        detail::queue_nodes.release(pred);                        // nobody spins on it any more
+    }
+
+private:
+    alignas(cache_line_size) std::atomic<node*> tail;
+    // Written and read by the holder only, as in mcs_lock
+    alignas(cache_line_size) node* holder = nullptr;
+    node* holder_pred = nullptr;
+};
+
+} // namespace async
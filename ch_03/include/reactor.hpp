@@ -0,0 +1,354 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "thread_pool.hpp"
+
+/**
+ * @brief epoll event loop for file descriptors, timerfd timers and posted tasks.
+ *
+ * @details
+ * One loop thread blocks in `epoll_wait` on everything at once:
+ * - `add_fd(fd, events, fn)`:       fn(uint32_t revents) when `fd` is ready
+ * - `add_timer(first, interval, fn)`: a timerfd; fn(uint64_t expirations)
+ *                                   on expiry (interval 0 = one-shot,
+ *                                   removed after it fires)
+ * - `post(fn)`:                     run fn() from another thread; an
+ *                                   eventfd wakes the loop
+ *
+ * Ready handlers run on `pool` if one is given, otherwise inline on the
+ * loop thread. Registrations use EPOLLONESHOT and are re-armed when the
+ * handler returns, so a handler never runs concurrently with itself even
+ * on a pool, and a slow handler cannot flood the pool with duplicates.
+ *
+ * Wakeup coalescing: `post()` appends to a queue and writes the eventfd
+ * only if no signal is already pending. A burst of N posts before the loop
+ * wakes costs one write(2) and one read(2) instead of N; the loop clears
+ * the pending flag before draining, so a post racing with the drain is
+ * either drained now or signals again.
+ *
+ * epoll carries a registration id, not a pointer, so `remove()` from any
+ * thread is safe even while the loop holds an event for it. Re-arming and
+ * `remove()` take a per-entry mutex, so once `remove()` returns the fd may
+ * be closed and its number reused without a stale re-arm. Timer fds are
+ * owned and closed by the reactor; plain fds stay owned by the caller
+ * (remove before closing). The destructor stops the loop and waits for
+ * handlers still running on the pool; queued posts are dropped.
+ *
+ * @code
+ * async::thread_pool pool;
+ * async::reactor loop(&pool);
+ * loop.add_fd(sock, EPOLLIN, [&](std::uint32_t) { handle_readable(sock); });
+ * loop.add_timer(100ms, 100ms, [](std::uint64_t n) { tick(n); });
+ * loop.post([] { sync_cout << "on the loop\n"; });
+ * @endcode
+ */
+
+namespace async {
+
+namespace detail {
+
+struct reactor_entry {
+    virtual ~reactor_entry() {
+        if (owns_fd) ::close(fd);
+    }
+    virtual void call(std::uint64_t arg) = 0;
+
+    int fd = -1;
+    std::uint32_t events = 0;
+    bool owns_fd = false;
+    bool timer = false;
+    bool one_shot = false;
+
+    std::mutex ctl_mtx;   // guards `removed` and epoll_ctl on `fd`
+    bool removed = false;
+};
+
+template <class F>
+struct reactor_entry_model final : reactor_entry {
+    explicit reactor_entry_model(F f) : fn(std::move(f)) {}
+
+    void call(std::uint64_t arg) override {
+        if constexpr (std::is_invocable_v<F&, std::uint64_t>) {
+            fn(arg);
+        } else {
+            fn();
+        }
+    }
+
+    F fn;
+};
+
+inline void throw_errno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+} // namespace detail
+
+class reactor {
+public:
+    using clock = std::chrono::steady_clock;
+    using watch_id = std::uint64_t;
+
+    struct statistics {
+        std::uint64_t posted;    // post() calls
+        std::uint64_t signals;   // eventfd writes they cost
+        std::uint64_t loops;     // epoll_wait returns
+        std::uint64_t events;    // handlers dispatched
+    };
+
+    explicit reactor(thread_pool* pool = nullptr) : executor(pool) {
+        epfd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (epfd < 0) detail::throw_errno("epoll_create1");
+        wakefd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakefd < 0) {
+            ::close(epfd);
+            detail::throw_errno("eventfd");
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = wake_id;
+        if (::epoll_ctl(epfd, EPOLL_CTL_ADD, wakefd, &ev) < 0) {
+            const int err = errno;
+            ::close(wakefd);
+            ::close(epfd);
+            throw std::system_error(err, std::generic_category(), "epoll_ctl");
+        }
+
+        loop = std::jthread([this] { run(); });
+    }
+
+    ~reactor() {
+        stopping.store(true, std::memory_order_release);
+        wake_loop();
+        loop.join();
+
+        std::unique_lock<std::mutex> lock(flight_mtx);
+        idle_cv.wait(lock, [&] { return in_flight == 0; });
+        lock.unlock();
+
+        entries.clear();
+        ::close(wakefd);
+        ::close(epfd);
+    }
+
+    reactor(const reactor&) = delete;
+    reactor& operator=(const reactor&) = delete;
+
+    // `fn` is called as fn(revents) or fn()
+    template <class F>
+    watch_id add_fd(int fd, std::uint32_t events, F&& fn) {
+        auto entry = std::make_shared<detail::reactor_entry_model<std::decay_t<F>>>(std::forward<F>(fn));
+        entry->fd = fd;
+        entry->events = events;
+        return attach(std::move(entry));
+    }
+
+    // `fn` is called as fn(expirations) or fn(); interval == 0 fires once
+    template <class Rep1, class Period1, class Rep2, class Period2, class F>
+    watch_id add_timer(std::chrono::duration<Rep1, Period1> first, std::chrono::duration<Rep2, Period2> interval,
+                       F&& fn) {
+        const int fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (fd < 0) detail::throw_errno("timerfd_create");
+
+        auto entry = std::make_shared<detail::reactor_entry_model<std::decay_t<F>>>(std::forward<F>(fn));
+        entry->fd = fd;
+        entry->owns_fd = true;
+        entry->timer = true;
+        entry->one_shot = interval == interval.zero();
+        entry->events = EPOLLIN;
+
+        itimerspec spec{};
+        spec.it_value = to_timespec(std::max(std::chrono::nanoseconds(first), std::chrono::nanoseconds(1)));
+        spec.it_interval = to_timespec(std::chrono::nanoseconds(interval));
+        if (::timerfd_settime(fd, 0, &spec, nullptr) < 0) detail::throw_errno("timerfd_settime");
+        return attach(std::move(entry));
+    }
+
+    // False if `id` is unknown or already removed; a running handler completes
+    bool remove(watch_id id) {
+        std::shared_ptr<detail::reactor_entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(entries_mtx);
+            auto it = entries.find(id);
+            if (it == entries.end()) return false;
+            entry = std::move(it->second);
+            entries.erase(it);
+        }
+        std::lock_guard<std::mutex> lock(entry->ctl_mtx);
+        entry->removed = true;
+        ::epoll_ctl(epfd, EPOLL_CTL_DEL, entry->fd, nullptr);
+        return true;
+    }
+
+    template <class F>
+    void post(F&& fn) {
+        {
+            std::lock_guard<std::mutex> lock(post_mtx);
+            posted.emplace_back(std::forward<F>(fn));
+        }
+        posts.fetch_add(1, std::memory_order_relaxed);
+        // Only the first post since the loop last drained pays for a syscall
+        if (!wake_pending.load(std::memory_order_acquire) &&
+            !wake_pending.exchange(true, std::memory_order_acq_rel)) {
+            wake_loop();
+        }
+    }
+
+    statistics stats() const {
+        return {posts.load(std::memory_order_relaxed), signals.load(std::memory_order_relaxed),
+                loops.load(std::memory_order_relaxed), dispatched.load(std::memory_order_relaxed)};
+    }
+
+private:
+    static constexpr watch_id wake_id = 0;
+    static constexpr int max_events = 64;
+
+    static timespec to_timespec(std::chrono::nanoseconds ns) {
+        timespec ts{};
+        ts.tv_sec = static_cast<time_t>(ns.count() / 1'000'000'000);
+        ts.tv_nsec = static_cast<long>(ns.count() % 1'000'000'000);
+        return ts;
+    }
+
+    watch_id attach(std::shared_ptr<detail::reactor_entry> entry) {
+        std::lock_guard<std::mutex> lock(entries_mtx);
+        const watch_id id = next_id++;
+        epoll_event ev{};
+        ev.events = entry->events | EPOLLONESHOT;
+        ev.data.u64 = id;
+        if (::epoll_ctl(epfd, EPOLL_CTL_ADD, entry->fd, &ev) < 0) detail::throw_errno("epoll_ctl");
+        entries.emplace(id, std::move(entry));
+        return id;
+    }
+
+    void wake_loop() {
+        signals.fetch_add(1, std::memory_order_relaxed);
+        const std::uint64_t one = 1;
+        [[maybe_unused]] auto rc = ::write(wakefd, &one, sizeof one);
+    }
+
+    void rearm(watch_id id, detail::reactor_entry& entry) {
+        std::lock_guard<std::mutex> lock(entry.ctl_mtx);
+        if (entry.removed) return;
+        epoll_event ev{};
+        ev.events = entry.events | EPOLLONESHOT;
+        ev.data.u64 = id;
+        ::epoll_ctl(epfd, EPOLL_CTL_MOD, entry.fd, &ev);
+    }
+
+    void dispatch(task fn) {
+        dispatched.fetch_add(1, std::memory_order_relaxed);
+        if (!executor) {
+            fn();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(flight_mtx);
+            ++in_flight;
+        }
+        executor->submit([this, fn = std::move(fn)]() mutable {
+            fn();
+            std::lock_guard<std::mutex> lock(flight_mtx);
+            if (--in_flight == 0) idle_cv.notify_all();
+        });
+    }
+
+    void drain_posts() {
+        std::uint64_t count;
+        [[maybe_unused]] auto rc = ::read(wakefd, &count, sizeof count);
+        wake_pending.store(false, std::memory_order_release);
+
+        {
+            std::lock_guard<std::mutex> lock(post_mtx);
+            draining.swap(posted);   // both buffers keep their capacity
+        }
+        for (auto& fn : draining) dispatch(std::move(fn));
+        draining.clear();
+    }
+
+    void on_event(watch_id id, std::uint32_t revents) {
+        std::shared_ptr<detail::reactor_entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(entries_mtx);
+            auto it = entries.find(id);
+            if (it == entries.end()) return;   // removed after epoll_wait returned
+            entry = it->second;
+        }
+
+        std::uint64_t arg = revents;
+        if (entry->timer) {
+            if (::read(entry->fd, &arg, sizeof arg) != static_cast<ssize_t>(sizeof arg)) {
+                rearm(id, *entry);
+                return;
+            }
+        }
+        dispatch([this, id, arg, entry = std::move(entry)] {
+            entry->call(arg);
+            if (entry->one_shot) {
+                remove(id);
+            } else {
+                rearm(id, *entry);
+            }
+        });
+    }
+
+    void run() {
+        epoll_event events[max_events];
+        while (!stopping.load(std::memory_order_acquire)) {
+            const int n = ::epoll_wait(epfd, events, max_events, -1);
+            if (n < 0) continue;   // EINTR
+            loops.fetch_add(1, std::memory_order_relaxed);
+            for (int i = 0; i < n && !stopping.load(std::memory_order_acquire); ++i) {
+                if (events[i].data.u64 == wake_id) {
+                    drain_posts();
+                } else {
+                    on_event(events[i].data.u64, events[i].events);
+                }
+            }
+        }
+    }
+
+    thread_pool* const executor;
+    int epfd = -1;
+    int wakefd = -1;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> wake_pending{false};
+
+    std::mutex entries_mtx;
+    std::unordered_map<watch_id, std::shared_ptr<detail::reactor_entry>> entries;
+    watch_id next_id = 1;
+
+    std::mutex post_mtx;
+    std::vector<task> posted;
+    std::vector<task> draining;   // loop thread only
+
+    std::mutex flight_mtx;
+    std::condition_variable idle_cv;
+    std::size_t in_flight = 0;
+
+    std::atomic<std::uint64_t> posts{0}, signals{0}, loops{0}, dispatched{0};
+
+    std::jthread loop;
+};
+
+} // namespace async
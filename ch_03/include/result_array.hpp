@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cache_line.hpp"
+
+/**
+ * @brief Per-writer result slots without false sharing.
+ *
+ * @details
+ * In 06_return_vals.cpp every thread writes the same global `result`.
+ * Giving each of N workers its own element of a plain `std::vector<int>`
+ * removes the data race but not the contention: 16 ints share one 64-byte
+ * cache line, so every write invalidates the line in the other writers'
+ * caches (false sharing).
+ *
+ * `result_array<T>` gives every writer its own cache-line-aligned slot.
+ * `result_array<T, false>` is the packed layout, kept for comparison.
+ *
+ * Writers either `set(i, value)` or update `(*this)[i]` in place and then
+ * call `complete(i)`. Completion is counted down on a separate cache line;
+ * `gather()` blocks (atomic::wait) until every slot is complete and then
+ * compacts the values into a contiguous std::vector<T>.
+ *
+ * @code
+ * async::result_array<int> results(n);
+ * for (std::size_t i = 0; i < n; ++i)
+ *     pool.submit([&, i] { results.set(i, compute(i)); });
+ * std::vector<int> all = results.gather();
+ * @endcode
+ */
+
+namespace async {
+
+template <class T, bool Padded = true>
+class result_array {
+public:
+    explicit result_array(std::size_t n)
+        : slots(std::make_unique<slot[]>(n)), count(n), remaining(n) {}
+
+    result_array(const result_array&) = delete;
+    result_array& operator=(const result_array&) = delete;
+
+    std::size_t size() const { return count; }
+
+    // Slot i is owned by writer i until complete(i)
+    T& operator[](std::size_t i) { return slots[i].value; }
+    const T& operator[](std::size_t i) const { return slots[i].value; }
+
+    void set(std::size_t i, T value) {
+        slots[i].value = std::move(value);
+        complete(i);
+    }
+
+    // Publishes slot i; each slot must be completed exactly once
+    void complete(std::size_t) {
+        if (remaining.value.fetch_sub(1, std::memory_order_release) == 1) {
+            remaining.value.notify_all();
+        }
+    }
+
+    bool ready() const { return remaining.value.load(std::memory_order_acquire) == 0; }
+
+    void wait() const {
+        for (std::size_t left = remaining.value.load(std::memory_order_acquire); left != 0;
+             left = remaining.value.load(std::memory_order_acquire)) {
+            remaining.value.wait(left, std::memory_order_acquire);
+        }
+    }
+
+    // Waits for every writer, then moves the values out in slot order
+    std::vector<T> gather() {
+        wait();
+        std::vector<T> out;
+        out.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) out.push_back(std::move(slots[i].value));
+        return out;
+    }
+
+private:
+    struct packed_slot {
+        T value{};
+    };
+
+    struct alignas(cache_line_size) padded_slot {
+        T value{};
+    };
+
+    using slot = std::conditional_t<Padded, padded_slot, packed_slot>;
+
+    struct alignas(cache_line_size) counter {
+        std::atomic<std::size_t> value;
+        explicit counter(std::size_t n) : value(n) {}
+    };
+
+    std::unique_ptr<slot[]> slots;
+    std::size_t count;
+    counter remaining;
+};
+
+} // namespace async
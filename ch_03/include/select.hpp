@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+
+#include "channel.hpp"
+#include "futex.hpp"
+
+/**
+ * @brief Go-style `select` over channels, a stop_token and a deadline.
+ *
+ * @details
+ * `select(cases...)` runs the handler of the first ready case and returns
+ * its index:
+ * - `on_recv(ch, fn)`:      fn(std::optional<T>) with a received value, or
+ *                           std::nullopt once `ch` is closed and drained
+ * - `on_stop(token, fn)`:   fn() once stop is requested
+ * - `on_deadline(tp, fn)`:  fn() once steady_clock reaches `tp`
+ *
+ * Fast path: every case is polled once in declaration order (a `try_recv`
+ * per channel); if one is ready nothing is registered anywhere, so a ready
+ * case costs about one `try_recv`. Declaration order is also the priority
+ * order when several cases are ready.
+ *
+ * Slow path: one `parked_waiter` (a single futex word) is registered with
+ * every channel and with a `std::stop_callback`. The cases are polled
+ * again after registration (closing the race with a concurrent send), then
+ * the thread parks on the futex with the earliest deadline as timeout.
+ * There is no polling loop: the thread only wakes when a source signals
+ * or the deadline passes.
+ *
+ * @code
+ * using namespace std::chrono_literals;
+ * while (true) {
+ *     auto idx = async::select(
+ *         async::on_stop(token, [] {}),
+ *         async::on_recv(data, [&](std::optional<int> v) { if (v) handle(*v); }),
+ *         async::on_deadline(next_tick, [&] { tick(); next_tick += 100ms; }));
+ *     if (idx == 0) break;
+ * }
+ * @endcode
+ */
+
+namespace async {
+
+template <class T, class F>
+class recv_case {
+public:
+    recv_case(channel<T>& c, F f) : ch(c), fn(std::move(f)) {}
+
+    bool try_fire() {
+        if (auto v = ch.try_recv()) {
+            fn(std::move(v));
+            return true;
+        }
+        if (ch.drained()) {
+            fn(std::optional<T>{});
+            return true;
+        }
+        return false;
+    }
+
+    void arm(detail::parked_waiter& w) { ch.add_recv_waiter(&w); }
+    void disarm(detail::parked_waiter& w) { ch.remove_recv_waiter(&w); }
+    std::chrono::steady_clock::time_point deadline() const { return std::chrono::steady_clock::time_point::max(); }
+
+private:
+    channel<T>& ch;
+    F fn;
+};
+
+template <class F>
+class stop_case {
+public:
+    stop_case(std::stop_token t, F f) : token(std::move(t)), fn(std::move(f)) {}
+
+    bool try_fire() {
+        if (!token.stop_requested()) return false;
+        fn();
+        return true;
+    }
+
+    void arm(detail::parked_waiter& w) { callback.emplace(token, signaller{&w}); }
+    void disarm(detail::parked_waiter&) { callback.reset(); }   // waits for a running callback
+    std::chrono::steady_clock::time_point deadline() const { return std::chrono::steady_clock::time_point::max(); }
+
+private:
+    struct signaller {
+        detail::parked_waiter* w;
+        void operator()() const { w->signal(); }
+    };
+
+    std::stop_token token;
+    F fn;
+    std::optional<std::stop_callback<signaller>> callback;
+};
+
+template <class F>
+class deadline_case {
+public:
+    deadline_case(std::chrono::steady_clock::time_point tp, F f) : when(tp), fn(std::move(f)) {}
+
+    bool try_fire() {
+        if (std::chrono::steady_clock::now() < when) return false;
+        fn();
+        return true;
+    }
+
+    void arm(detail::parked_waiter&) {}
+    void disarm(detail::parked_waiter&) {}
+    std::chrono::steady_clock::time_point deadline() const { return when; }
+
+private:
+    std::chrono::steady_clock::time_point when;
+    F fn;
+};
+
+template <class T, class F>
+recv_case<T, std::decay_t<F>> on_recv(channel<T>& ch, F&& fn) {
+    return {ch, std::forward<F>(fn)};
+}
+
+template <class F>
+stop_case<std::decay_t<F>> on_stop(std::stop_token token, F&& fn) {
+    return {std::move(token), std::forward<F>(fn)};
+}
+
+template <class F>
+deadline_case<std::decay_t<F>> on_deadline(std::chrono::steady_clock::time_point tp, F&& fn) {
+    return {tp, std::forward<F>(fn)};
+}
+
+template <class Rep, class Period, class F>
+deadline_case<std::decay_t<F>> on_timeout(std::chrono::duration<Rep, Period> d, F&& fn) {
+    return {std::chrono::steady_clock::now() + d, std::forward<F>(fn)};
+}
+
+/**
+ * Blocks until one case is ready, runs its handler and returns its index.
+ * Without a deadline or stop case it can block forever.
+ */
+template <class... Cases>
+std::size_t select(Cases&&... cases) {
+    static_assert(sizeof...(Cases) > 0, "select needs at least one case");
+
+    std::size_t fired = sizeof...(Cases);
+    auto poll = [&] {
+        std::size_t i = 0;
+        return ((cases.try_fire() ? (fired = i, true) : (++i, false)) || ...);
+    };
+
+    if (poll()) return fired;
+
+    detail::parked_waiter waiter;
+    const auto deadline = std::min({cases.deadline()...});
+
+    // Handlers may throw; the waiter must be unregistered before it goes away
+    auto disarm_all = [&] { (cases.disarm(waiter), ...); };
+    struct guard {
+        decltype(disarm_all)& disarm;
+        ~guard() { disarm(); }
+    };
+
+    (cases.arm(waiter), ...);
+    guard g{disarm_all};
+    while (true) {
+        waiter.arm();
+        if (poll()) break;
+        waiter.wait_until(deadline);
+    }
+    return fired;
+}
+
+} // namespace async
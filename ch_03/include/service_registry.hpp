@@ -0,0 +1,176 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Named background services with parallel, bounded shutdown.
+ *
+ * @details
+ * 07_daemon_threads.cpp detaches its daemon and has main() sleep long
+ * enough for it to finish, sharing a plain `int` between both threads.
+ * Here every daemon is registered instead:
+ *
+ * - `start(name, body, drain)` runs `body(std::stop_token)` (or `body()`)
+ *   on a new thread. `drain()` is optional and runs on that same thread
+ *   after `body` returns (or throws), to flush whatever the service still
+ *   holds.
+ * - `shutdown(timeout)` requests stop on every service at once, then waits
+ *   on a single completion counter until the last one has drained or the
+ *   timeout expires, whichever is first. Since drains run on the services'
+ *   own threads, they run in parallel.
+ * - Services still running at the deadline are detached and reported, so
+ *   process exit is bounded; they own their state through shared_ptrs and
+ *   never touch the registry again.
+ *
+ * An exception escaping `body` or `drain` is captured and reported instead
+ * of terminating the process. The destructor calls `shutdown()` with the
+ * default timeout if it has not run yet.
+ *
+ * @code
+ * async::service_registry services;
+ * services.start("flusher", [&](std::stop_token st) { while (!st.stop_requested()) flush(); },
+ *                [&] { flush(); });
+ * ...
+ * auto report = services.shutdown(2s);
+ * for (const auto& name : report.timed_out) sync_cout << name << " did not stop\n";
+ * @endcode
+ */
+
+namespace async {
+
+struct shutdown_report {
+    std::vector<std::string> stopped;
+    std::vector<std::string> timed_out;
+    std::vector<std::pair<std::string, std::exception_ptr>> failed;   // also listed in `stopped`
+    std::chrono::milliseconds elapsed{0};
+
+    bool clean() const { return timed_out.empty() && failed.empty(); }
+};
+
+namespace detail {
+
+struct service_state {
+    std::string name;
+    std::stop_source stop;
+    std::thread thread;
+    bool finished = false;          // guarded by service_core::mtx
+    std::exception_ptr error;       // written by the service before `finished`
+};
+
+struct service_core {
+    std::mutex mtx;
+    std::condition_variable done_cv;
+    std::size_t running = 0;
+};
+
+} // namespace detail
+
+class service_registry {
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds default_timeout{5000};
+
+    service_registry() = default;
+
+    ~service_registry() {
+        if (!shut_down) shutdown(default_timeout);
+    }
+
+    service_registry(const service_registry&) = delete;
+    service_registry& operator=(const service_registry&) = delete;
+
+    template <class Body, class Drain = std::nullptr_t>
+    void start(std::string name, Body&& body, Drain&& drain = nullptr) {
+        shut_down = false;
+        auto state = std::make_shared<detail::service_state>();
+        state->name = std::move(name);
+        {
+            std::lock_guard<std::mutex> lock(core->mtx);
+            ++core->running;
+        }
+
+        state->thread = std::thread(
+            [core = core, state, body = std::forward<Body>(body), drain = std::forward<Drain>(drain)]() mutable {
+                try {
+                    if constexpr (std::is_invocable_v<Body&, std::stop_token>) {
+                        body(state->stop.get_token());
+                    } else {
+                        body();
+                    }
+                } catch (...) {
+                    state->error = std::current_exception();
+                }
+                if constexpr (!std::is_null_pointer_v<std::decay_t<Drain>>) {
+                    try {
+                        drain();
+                    } catch (...) {
+                        if (!state->error) state->error = std::current_exception();
+                    }
+                }
+                std::lock_guard<std::mutex> lock(core->mtx);
+                state->finished = true;
+                if (--core->running == 0) core->done_cv.notify_all();
+            });
+        services.push_back(std::move(state));
+    }
+
+    std::size_t running() const {
+        std::lock_guard<std::mutex> lock(core->mtx);
+        return core->running;
+    }
+
+    // Stops every service in parallel and waits at most `timeout` for all of them
+    template <class Rep, class Period>
+    shutdown_report shutdown(std::chrono::duration<Rep, Period> timeout) {
+        const auto start = clock::now();
+        shut_down = true;
+        for (auto& s : services) s->stop.request_stop();
+
+        {
+            std::unique_lock<std::mutex> lock(core->mtx);
+            core->done_cv.wait_until(lock, start + timeout, [&] { return core->running == 0; });
+        }
+
+        shutdown_report report;
+        for (auto& s : services) {
+            bool finished;
+            {
+                std::lock_guard<std::mutex> lock(core->mtx);
+                finished = s->finished;
+            }
+            if (finished) {
+                s->thread.join();   // already past its last statement
+                report.stopped.push_back(s->name);
+                if (s->error) report.failed.emplace_back(s->name, s->error);
+            } else {
+                s->thread.detach();
+                report.timed_out.push_back(s->name);
+            }
+        }
+        services.clear();
+        core = std::make_shared<detail::service_core>();   // detached stragglers keep the old one
+        report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start);
+        return report;
+    }
+
+    shutdown_report shutdown() { return shutdown(default_timeout); }
+
+private:
+    std::shared_ptr<detail::service_core> core = std::make_shared<detail::service_core>();
+    std::vector<std::shared_ptr<detail::service_state>> services;
+    bool shut_down = false;
+};
+
+} // namespace async
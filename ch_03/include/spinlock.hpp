@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "cpu_relax.hpp"
+
+/**
+ * @brief Test-and-test-and-set spinlock with bounded exponential backoff.
+ *
+ * @details
+ * For critical sections of tens of nanoseconds a futex mutex costs more
+ * than the section itself once it has to sleep. `spinlock` never enters
+ * the kernel unless asked to yield:
+ *
+ * - `lock()` first tries one exchange; on failure it spins on a plain
+ *   load (the "test" before the test-and-set), so waiters share the line
+ *   read-only instead of bouncing it with failed RMWs;
+ * - between loads it issues `cpu_relax()` (`pause`) `backoff` times, and
+ *   `backoff` doubles from `min_backoff` up to `max_backoff` while the
+ *   lock stays taken, which spreads out retries when many threads wait;
+ * - with `yield_after > 0`, every `yield_after`-th failed poll calls
+ *   `std::this_thread::yield()`, so a waiter gives its core back when the
+ *   holder was preempted (oversubscribed machines, `nproc` == 1).
+ *
+ * Satisfies Lockable (`lock`, `try_lock`, `unlock`), so std::lock_guard,
+ * std::unique_lock and std::scoped_lock work. Not fair: a releasing thread
+ * can take the lock straight back (queue_locks.hpp has FIFO locks).
+ *
+ * @code
+ * async::spinlock lock;   // or spinlock({.yield_after = 64})
+ * {
+ *     std::lock_guard<async::spinlock> guard(lock);
+ *     ++counter;
+ * }
+ * @endcode
+ */
+
+namespace async {
+
+struct spin_backoff {
+    std::uint32_t min_backoff = 4;      // pauses after the first failed poll
+    std::uint32_t max_backoff = 1024;   // cap for the doubling
+    std::uint32_t yield_after = 0;      // polls between yields; 0 = never yield
+};
+
+class spinlock {
+public:
+    explicit spinlock(spin_backoff b = {}) noexcept : backoff(b) {}
+
+    spinlock(const spinlock&) = delete;
+    spinlock& operator=(const spinlock&) = delete;
+
+    void lock() noexcept {
+        if (!locked.exchange(true, std::memory_order_acquire)) [[likely]] return;
+        lock_contended();
+    }
+
+    bool try_lock() noexcept {
+        return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() noexcept { locked.store(false, std::memory_order_release); }
+
+    bool is_locked() const noexcept { return locked.load(std::memory_order_relaxed); }
+
+private:
+    [[gnu::noinline]] void lock_contended() noexcept {
+        std::uint32_t pauses = backoff.min_backoff;
+        std::uint32_t polls = 0;
+        do {
+            while (locked.load(std::memory_order_relaxed)) {
+                for (std::uint32_t i = 0; i < pauses; ++i) cpu_relax();
+                pauses = std::min(pauses * 2, backoff.max_backoff);
+                if (backoff.yield_after && ++polls == backoff.yield_after) {
+                    polls = 0;
+                    std::this_thread::yield();
+                }
+            }
+        } while (locked.exchange(true, std::memory_order_acquire));
+    }
+
+    std::atomic<bool> locked{false};
+    spin_backoff backoff;
+};
+
+} // namespace async
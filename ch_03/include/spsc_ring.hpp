@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "cache_line.hpp"
+
+/**
+ * @brief Wait-free single-producer/single-consumer ring buffer.
+ *
+ * @details
+ * For fixed producer/consumer pairs (the two-thread setups of
+ * 02_cout_raceconditions.cpp and 09_move_threads.cpp) the CAS loops of a
+ * general MPMC channel are unnecessary: each index has exactly one writer.
+ *
+ * - Capacity is a power of two, so wrapping is a mask.
+ * - `tail` (written by the producer) and `head` (written by the consumer)
+ *   sit on separate cache lines.
+ * - Each side keeps a private cached copy of the other side's index on its
+ *   own line and only re-reads the shared one when the cache says the ring
+ *   is full / empty. In steady state a push or pop touches no cache line
+ *   owned by the other core except the slot itself.
+ * - `push_batch()` / `pop_batch()` move many elements with a single
+ *   release store of the index.
+ *
+ * Every operation finishes in a bounded number of steps (no retry loops).
+ * Only one thread may push and only one may pop.
+ *
+ * @code
+ * async::spsc_ring<int> ring(1024);
+ * std::jthread producer([&] { for (int i = 0; i < n; ++i) while (!ring.try_push(i)) { } });
+ * while (received < n) if (auto v = ring.try_pop()) ++received;
+ * @endcode
+ */
+
+namespace async {
+
+template <class T>
+class spsc_ring {
+public:
+    explicit spsc_ring(std::size_t capacity)
+        : mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+          slots(std::make_unique<storage[]>(mask + 1)) {}
+
+    ~spsc_ring() {
+        while (try_pop()) { }
+    }
+
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+
+    // Producer side
+    template <class U>
+    bool try_push(U&& value) {
+        const std::size_t tail = prod.tail.load(std::memory_order_relaxed);
+        if (tail - prod.cached_head > mask) {
+            prod.cached_head = cons.head.load(std::memory_order_acquire);
+            if (tail - prod.cached_head > mask) return false;
+        }
+        ::new (slots[tail & mask].bytes) T(std::forward<U>(value));
+        prod.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side: pushes up to `n` elements from `first`, publishes once
+    template <class It>
+    std::size_t push_batch(It first, std::size_t n) {
+        const std::size_t tail = prod.tail.load(std::memory_order_relaxed);
+        std::size_t space = capacity() - (tail - prod.cached_head);
+        if (space < n) {
+            prod.cached_head = cons.head.load(std::memory_order_acquire);
+            space = capacity() - (tail - prod.cached_head);
+        }
+        n = std::min(n, space);
+        for (std::size_t i = 0; i < n; ++i, ++first) {
+            ::new (slots[(tail + i) & mask].bytes) T(*first);
+        }
+        prod.tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer side
+    std::optional<T> try_pop() {
+        const std::size_t head = cons.head.load(std::memory_order_relaxed);
+        if (head == cons.cached_tail) {
+            cons.cached_tail = prod.tail.load(std::memory_order_acquire);
+            if (head == cons.cached_tail) return std::nullopt;
+        }
+        T* slot = at(head);
+        std::optional<T> value(std::move(*slot));
+        slot->~T();
+        cons.head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    // Consumer side: pops up to `max` elements into `out`, publishes once
+    template <class OutIt>
+    std::size_t pop_batch(OutIt out, std::size_t max) {
+        const std::size_t head = cons.head.load(std::memory_order_relaxed);
+        std::size_t available = cons.cached_tail - head;
+        if (available < max) {
+            cons.cached_tail = prod.tail.load(std::memory_order_acquire);
+            available = cons.cached_tail - head;
+        }
+        const std::size_t n = std::min(max, available);
+        for (std::size_t i = 0; i < n; ++i) {
+            T* slot = at(head + i);
+            *out++ = std::move(*slot);
+            slot->~T();
+        }
+        cons.head.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // Approximate when called concurrently
+    std::size_t size() const {
+        return prod.tail.load(std::memory_order_acquire) - cons.head.load(std::memory_order_acquire);
+    }
+
+private:
+    struct storage {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    T* at(std::size_t index) { return std::launder(reinterpret_cast<T*>(slots[index & mask].bytes)); }
+
+    struct alignas(cache_line_size) producer_line {
+        std::atomic<std::size_t> tail{0};
+        std::size_t cached_head = 0;
+    };
+
+    struct alignas(cache_line_size) consumer_line {
+        std::atomic<std::size_t> head{0};
+        std::size_t cached_tail = 0;
+    };
+
+    const std::size_t mask;
+    std::unique_ptr<storage[]> slots;
+
+    producer_line prod;
+    consumer_line cons;
+};
+
+} // namespace async
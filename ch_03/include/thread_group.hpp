@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "futex.hpp"
+
+/**
+ * @brief N threads, one stop_source, one completion counter.
+ *
+ * @details
+ * A container of std::jthread (or the JthreadWrapper objects in
+ * 08_jthread.cpp) shuts down one element at a time: each destructor
+ * requests stop on *its* thread and joins it before the next thread even
+ * learns it should stop. With threads that need time to wind down, the
+ * total is the sum of those times.
+ *
+ * `thread_group` gives every thread the same stop_token:
+ * - `request_stop_all()` is one `request_stop()` that all threads see;
+ * - every thread decrements one atomic counter as its last action, and
+ *   `wait()` / `wait_until()` sleep on that counter (a futex), waking once
+ *   when the last thread is done instead of N times;
+ * - `join_all()` waits on the counter and then joins; by then each join
+ *   only reaps a thread that has already finished.
+ * So the shutdown takes as long as the slowest thread, not the sum.
+ *
+ * `spawn(f, args...)` calls `f(stop_token, args...)` if that is valid,
+ * otherwise `f(args...)`. The destructor requests stop and joins. After
+ * `join_all()` the group is empty and has a fresh stop_source.
+ *
+ * The members are plain std::thread, not std::jthread. A jthread carries
+ * its own stop_source, and its token cannot be replaced by the group's,
+ * so each member would allocate a stop state that nothing watches. The
+ * group's destructor gives the jthread guarantee (request stop, then
+ * join) to all members at once.
+ *
+ * @code
+ * async::thread_group workers;
+ * for (int i = 0; i < 8; ++i) {
+ *     workers.spawn([](std::stop_token st, int id) { while (!st.stop_requested()) work(id); }, i);
+ * }
+ * workers.request_stop_all();
+ * workers.join_all();
+ * @endcode
+ */
+
+namespace async {
+
+class thread_group {
+public:
+    using clock = std::chrono::steady_clock;
+
+    thread_group() = default;
+
+    ~thread_group() {
+        request_stop_all();
+        join_all();
+    }
+
+    thread_group(const thread_group&) = delete;
+    thread_group& operator=(const thread_group&) = delete;
+
+    template <class F, class... Args>
+    void spawn(F&& f, Args&&... args) {
+        remaining.fetch_add(1, std::memory_order_relaxed);
+        try {
+            threads.emplace_back([this, token = stop.get_token(), f = std::forward<F>(f),
+                                  ... args = std::forward<Args>(args)]() mutable {
+                if constexpr (std::is_invocable_v<F&, std::stop_token, Args&...>) {
+                    f(token, args...);
+                } else {
+                    f(args...);
+                }
+                finished();
+            });
+        } catch (...) {
+            finished();
+            throw;
+        }
+    }
+
+    void request_stop_all() noexcept { stop.request_stop(); }
+
+    std::stop_token get_stop_token() const noexcept { return stop.get_token(); }
+
+    std::size_t size() const noexcept { return threads.size(); }
+
+    std::size_t running() const noexcept { return remaining.load(std::memory_order_acquire); }
+
+    // Blocks until every thread has returned from its function
+    void wait() {
+        for (std::uint32_t n; (n = remaining.load(std::memory_order_acquire)) != 0;) {
+            detail::futex_wait_until(&remaining, n, clock::time_point::max());
+        }
+    }
+
+    // False on timeout
+    bool wait_until(clock::time_point deadline) {
+        for (std::uint32_t n; (n = remaining.load(std::memory_order_acquire)) != 0;) {
+            if (!detail::futex_wait_until(&remaining, n, deadline)) {
+                return remaining.load(std::memory_order_acquire) == 0;
+            }
+        }
+        return true;
+    }
+
+    template <class Rep, class Period>
+    bool wait_for(std::chrono::duration<Rep, Period> timeout) {
+        return wait_until(clock::now() + timeout);
+    }
+
+    void join_all() {
+        wait();
+        for (auto& t : threads) t.join();
+        threads.clear();
+        stop = std::stop_source{};
+    }
+
+private:
+    void finished() {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) detail::futex_wake(&remaining, INT_MAX);
+    }
+
+    std::stop_source stop;
+    std::atomic<std::uint32_t> remaining{0};
+    std::vector<std::thread> threads;
+};
+
+} // namespace async
@@ -0,0 +1,530 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Fixed-size thread pool with per-submit priorities.
+ *
+ * @details
+ * Every `submit()` carries a `priority`. Each level has its own FIFO queue
+ * and workers pick the next task with one of two policies:
+ *
+ * - `dequeue_policy::strict`: always the highest non-empty level. To keep
+ *   low levels from starving under a steady stream of high-priority work,
+ *   a queued task is promoted one level for every `aging_step` it has
+ *   waited (aging_step == 0 disables aging). Only the front of each queue
+ *   is inspected, so picking a task is O(levels).
+ *
+ * - `dequeue_policy::weighted_fair`: deficit round robin. Level i may run
+ *   `weights[i]` tasks per round while higher levels still have credit,
+ *   so every level gets a guaranteed share and aging is not needed.
+ *
+ * All queues are protected by one mutex and one condition variable; the
+ * tasks themselves run outside the lock.
+ *
+ * Elastic mode (`max_threads > threads`): the pool starts `threads` workers
+ * and grows up to `max_threads` when
+ * - the queue holds at least `spawn_queue_depth` more tasks than there are
+ *   idle workers, or
+ * - a worker enters a `blocking_section` while more tasks are queued than
+ *   there are idle workers (the blocked worker is compensated for).
+ * Spawns are at least `spawn_cooldown` apart; without a cooldown a large
+ * `submit_bulk()` may spawn several workers at once. A worker above the minimum
+ * that finds no work for `keep_alive` retires. Raising `spawn_queue_depth`,
+ * `spawn_cooldown` and `keep_alive` adds hysteresis. Whether to grow is
+ * decided under the lock; creating the threads and reaping retired ones
+ * happen after it is released, so neither blocks submitters or workers.
+ *
+ * @code
+ * async::thread_pool pool;
+ * pool.submit([] { handle_request(); }, async::priority::high);
+ * pool.submit([] { rebuild_index(); }, async::priority::low);
+ * pool.wait_idle();
+ * @endcode
+ */
+
+namespace async {
+
+class thread_pool;
+
+namespace detail {
+    inline thread_local thread_pool* current_pool = nullptr;
+}
+
+enum class priority : unsigned { high = 0, normal = 1, low = 2 };
+
+inline constexpr std::size_t priority_levels = 3;
+
+enum class dequeue_policy { strict, weighted_fair };
+
+struct thread_pool_options {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    dequeue_policy policy = dequeue_policy::strict;
+
+    // weighted_fair: tasks per round for high, normal, low
+    std::array<unsigned, priority_levels> weights{8, 4, 1};
+
+    // strict: a waiting task is promoted one level per aging_step (0 = off)
+    std::chrono::microseconds aging_step{10'000};
+
+    // Elastic mode: grow up to max_threads (0 or <= threads = fixed size)
+    unsigned max_threads = 0;
+    std::size_t spawn_queue_depth = 1;
+    std::chrono::microseconds spawn_cooldown{0};
+    std::chrono::milliseconds keep_alive{1000};
+};
+
+/**
+ * Type-erased, move-only `void()` callable (std::function requires the
+ * callable to be copyable, which rules out tasks owning promises).
+ */
+class task {
+public:
+    task() = default;
+
+    template <class F, class = std::enable_if_t<!std::is_same_v<std::decay_t<F>, task>>>
+    task(F&& f) : impl(std::make_unique<model<std::decay_t<F>>>(std::forward<F>(f))) {}
+
+    void operator()() { impl->call(); }
+    explicit operator bool() const { return impl != nullptr; }
+
+private:
+    struct concept_t {
+        virtual ~concept_t() = default;
+        virtual void call() = 0;
+    };
+
+    template <class F>
+    struct model final : concept_t {
+        explicit model(F&& f) : fn(std::move(f)) {}
+        explicit model(const F& f) : fn(f) {}
+        void call() override { fn(); }
+        F fn;
+    };
+
+    std::unique_ptr<concept_t> impl;
+};
+
+class thread_pool {
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct statistics {
+        std::size_t threads;
+        std::size_t peak_threads;
+        std::size_t spawned;
+        std::size_t retired;
+        std::size_t blocked;
+    };
+
+    explicit thread_pool(thread_pool_options opts = {}) : options(opts) {
+        options.threads = std::max(1u, options.threads);
+        options.max_threads = std::max(options.threads, options.max_threads);
+        credits = options.weights;
+
+        resize_plan plan;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            workers.reserve(options.threads);
+            for (unsigned i = 0; i < options.threads; ++i) reserve_worker(plan);
+        }
+        resize(plan);
+    }
+
+    // Runs every task still queued, then joins the workers
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        work_cv.notify_all();
+        // A task still running may have reserved workers just before `stopping`;
+        // they are added once it returns, so repeat until nothing is left
+        while (true) {
+            std::vector<std::thread> to_join;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                to_join = std::move(workers);
+                workers.clear();
+                for (auto& t : retired_workers) to_join.push_back(std::move(t));
+                retired_workers.clear();
+            }
+            if (to_join.empty()) break;
+            for (auto& w : to_join) w.join();
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    template <class F>
+    void submit(F&& f, priority p = priority::normal) {
+        bool wake;
+        resize_plan plan;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            queues[static_cast<std::size_t>(p)].push_back({task(std::forward<F>(f)), clock::now()});
+            ++pending;
+            ++queued_count;
+            wake = idle > 0;
+            maybe_grow(false, plan);
+        }
+        if (wake) work_cv.notify_one();
+        resize(plan);
+    }
+
+    // Skipped if `st` is stopped before the task starts; `f` receives `st` if it accepts one
+    template <class F>
+    void submit(std::stop_token st, F&& f, priority p = priority::normal) {
+        submit([st = std::move(st), f = std::forward<F>(f)] () mutable {
+            if (st.stop_requested()) return;
+            if constexpr (std::is_invocable_v<std::decay_t<F>&, std::stop_token>) {
+                f(st);
+            } else {
+                f();
+            }
+        }, p);
+    }
+
+    /**
+     * Submits a copy of every callable in [first, last) under one lock
+     * acquisition and wakes at most min(n, idle) workers. Use
+     * std::make_move_iterator to move the callables instead.
+     */
+    template <class It>
+    void submit_bulk(It first, It last, priority p = priority::normal) {
+        std::size_t wake, idle_seen;
+        resize_plan plan;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            auto& q = queues[static_cast<std::size_t>(p)];
+            const auto now = clock::now();
+            std::size_t n = 0;
+            for (; first != last; ++first, ++n) q.push_back({task(*first), now});
+            pending += n;
+            queued_count += n;
+            idle_seen = idle;
+            wake = std::min(n, idle);
+            maybe_grow(false, plan);
+        }
+        notify_workers(wake, idle_seen);
+        resize(plan);
+    }
+
+    /**
+     * Submits n tasks sharing one copy of `fn`. Task i calls fn(i) if `fn`
+     * accepts an index, fn() otherwise.
+     */
+    template <class F>
+    void submit_n(std::size_t n, F&& fn, priority p = priority::normal) {
+        auto shared = std::make_shared<std::decay_t<F>>(std::forward<F>(fn));
+        std::size_t wake, idle_seen;
+        resize_plan plan;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            auto& q = queues[static_cast<std::size_t>(p)];
+            const auto now = clock::now();
+            for (std::size_t i = 0; i < n; ++i) {
+                q.push_back({task([shared, i] {
+                    if constexpr (std::is_invocable_v<std::decay_t<F>&, std::size_t>) {
+                        (*shared)(i);
+                    } else {
+                        (*shared)();
+                    }
+                }), now});
+            }
+            pending += n;
+            queued_count += n;
+            idle_seen = idle;
+            wake = std::min(n, idle);
+            maybe_grow(false, plan);
+        }
+        notify_workers(wake, idle_seen);
+        resize(plan);
+    }
+
+    // The pool whose worker is running the calling thread, or nullptr
+    static thread_pool* current() { return detail::current_pool; }
+
+    // Blocks until every submitted task has finished
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(mtx);
+        idle_cv.wait(lock, [this] { return pending == 0; });
+    }
+
+    std::size_t thread_count() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return live;
+    }
+
+    std::size_t queued() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return queued_count;
+    }
+
+    statistics stats() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return {live, peak, spawned, retired, blocked};
+    }
+
+private:
+    friend class blocking_section;
+
+    struct entry {
+        task fn;
+        clock::time_point enqueued;
+    };
+
+    // Decided under mtx, carried out by resize() after it is released
+    struct resize_plan {
+        std::size_t spawn = 0;
+        std::vector<std::thread> reap;   // retired workers, exited or about to
+    };
+
+    bool elastic() const { return options.max_threads > options.threads; }
+
+    // Wakes `n` of the `idle` workers counted under the lock
+    void notify_workers(std::size_t n, std::size_t idle_seen) {
+        if (n == 0) return;
+        if (n >= idle_seen) {
+            work_cv.notify_all();   // every sleeper has a task waiting
+        } else {
+            for (std::size_t i = 0; i < n; ++i) work_cv.notify_one();
+        }
+    }
+
+    // Called with mtx held: counts the worker as live now, so later
+    // decisions see it, and hands retired handles to the plan for reaping
+    void reserve_worker(resize_plan& plan) {
+        for (auto& t : retired_workers) plan.reap.push_back(std::move(t));
+        retired_workers.clear();
+
+        ++plan.spawn;
+        ++live;
+        ++starting;
+        ++spawned;
+        peak = std::max(peak, live);
+        last_spawn = clock::now();
+    }
+
+    // Called without mtx: joins and starts the threads `plan` asks for
+    void resize(resize_plan& plan) {
+        for (auto& t : plan.reap) t.join();
+        if (plan.spawn == 0) return;
+
+        std::vector<std::thread> started;
+        started.reserve(plan.spawn);
+        try {
+            while (started.size() < plan.spawn) started.emplace_back([this] { worker_loop(); });
+        } catch (...) {
+            adopt(started, plan.spawn - started.size());
+            throw;
+        }
+        adopt(started, 0);
+    }
+
+    // A worker may already have retired before its handle arrives here; the
+    // handle then stays in `workers` and the destructor joins it
+    void adopt(std::vector<std::thread>& started, std::size_t failed) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto& t : started) workers.push_back(std::move(t));
+        live -= failed;
+        starting -= failed;
+        spawned -= failed;
+    }
+
+    // Called with mtx held after new work or a newly blocked worker
+    void maybe_grow(bool worker_blocked, resize_plan& plan) {
+        if (!elastic() || stopping || live >= options.max_threads) return;
+        if (options.spawn_cooldown.count() > 0 && clock::now() - last_spawn < options.spawn_cooldown) return;
+
+        // Idle and just-spawned workers will pick up that many tasks without help
+        const bool compensate = worker_blocked && queued_count > idle + starting;
+        if (compensate) {
+            reserve_worker(plan);
+            if (options.spawn_cooldown.count() > 0) return;
+        }
+        while (live < options.max_threads && queued_count >= idle + starting + options.spawn_queue_depth) {
+            reserve_worker(plan);
+            if (options.spawn_cooldown.count() > 0) break;
+        }
+    }
+
+    // Called with mtx held: moves this worker's handle to retired_workers
+    void retire_self() {
+        const auto id = std::this_thread::get_id();
+        for (auto it = workers.begin(); it != workers.end(); ++it) {
+            if (it->get_id() == id) {
+                retired_workers.push_back(std::move(*it));
+                workers.erase(it);
+                break;
+            }
+        }
+        --live;
+        ++retired;
+    }
+
+    void worker_loop() {
+        detail::current_pool = this;
+        std::unique_lock<std::mutex> lock(mtx);
+        --starting;
+        const auto ready = [this] { return stopping || has_work(); };
+        while (true) {
+            ++idle;
+            bool woke = true;
+            if (elastic() && live > options.threads) {
+                woke = work_cv.wait_for(lock, options.keep_alive, ready);
+            } else {
+                work_cv.wait(lock, ready);
+            }
+            --idle;
+
+            if (!woke) {
+                if (live > options.threads) {
+                    retire_self();
+                    return;
+                }
+                continue;
+            }
+            if (!has_work()) return;   // stopping and drained
+
+            task fn = pop_next();
+            lock.unlock();
+            fn();
+            lock.lock();
+
+            if (--pending == 0) idle_cv.notify_all();
+        }
+    }
+
+    bool has_work() const {
+        for (const auto& q : queues) {
+            if (!q.empty()) return true;
+        }
+        return false;
+    }
+
+    // Called with mtx held and at least one queue non-empty
+    task pop_next() {
+        const std::size_t level = options.policy == dequeue_policy::strict ? pick_strict()
+                                                                           : pick_weighted();
+        task fn = std::move(queues[level].front().fn);
+        queues[level].pop_front();
+        --queued_count;
+        return fn;
+    }
+
+    std::size_t pick_strict() const {
+        const auto now = clock::now();
+        const auto step = options.aging_step.count();
+
+        std::size_t best = priority_levels;
+        long long best_rank = 0;
+        for (std::size_t i = 0; i < priority_levels; ++i) {
+            if (queues[i].empty()) continue;
+            long long rank = static_cast<long long>(i);
+            if (step > 0) {
+                auto waited = std::chrono::duration_cast<std::chrono::microseconds>(
+                    now - queues[i].front().enqueued).count();
+                rank -= waited / step;
+            }
+            if (best == priority_levels || rank < best_rank) {
+                best = i;
+                best_rank = rank;
+            }
+        }
+        return best;
+    }
+
+    std::size_t pick_weighted() {
+        for (int round = 0; round < 2; ++round) {
+            for (std::size_t i = 0; i < priority_levels; ++i) {
+                if (!queues[i].empty() && credits[i] > 0) {
+                    --credits[i];
+                    return i;
+                }
+            }
+            credits = options.weights;   // every non-empty level is out of credit
+        }
+        // All weights are zero: fall back to strict order
+        for (std::size_t i = 0; i < priority_levels; ++i) {
+            if (!queues[i].empty()) return i;
+        }
+        return 0;
+    }
+
+    thread_pool_options options;
+
+    mutable std::mutex mtx;
+    std::condition_variable work_cv;
+    std::condition_variable idle_cv;
+    std::array<std::deque<entry>, priority_levels> queues;
+    std::array<unsigned, priority_levels> credits{};
+    std::size_t pending = 0;   // queued + running
+    std::size_t queued_count = 0;
+    bool stopping = false;
+
+    std::size_t live = 0;
+    std::size_t idle = 0;
+    std::size_t starting = 0;   // spawned, not yet in worker_loop
+    std::size_t blocked = 0;
+    std::size_t peak = 0;
+    std::size_t spawned = 0;
+    std::size_t retired = 0;
+    clock::time_point last_spawn{};
+
+    std::vector<std::thread> workers;
+    std::vector<std::thread> retired_workers;
+};
+
+/**
+ * Marks the enclosing scope of a pool task as blocking (sleep, I/O, lock
+ * wait). In elastic mode the pool may spawn a replacement worker so queued
+ * tasks keep running. No-op outside a pool worker.
+ *
+ * @code
+ * pool.submit([] {
+ *     async::blocking_section blocking;
+ *     std::this_thread::sleep_for(1s);
+ * });
+ * @endcode
+ */
+class blocking_section {
+public:
+    blocking_section() : pool(thread_pool::current()) {
+        if (!pool) return;
+        thread_pool::resize_plan plan;
+        {
+            std::lock_guard<std::mutex> lock(pool->mtx);
+            ++pool->blocked;
+            pool->maybe_grow(true, plan);
+        }
+        pool->resize(plan);
+    }
+
+    ~blocking_section() {
+        if (!pool) return;
+        std::lock_guard<std::mutex> lock(pool->mtx);
+        --pool->blocked;
+    }
+
+    blocking_section(const blocking_section&) = delete;
+    blocking_section& operator=(const blocking_section&) = delete;
+
+private:
+    thread_pool* pool;
+};
+
+} // namespace async
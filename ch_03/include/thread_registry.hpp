@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "cache_line.hpp"
+
+/**
+ * @brief OS-visible thread names and a lock-free registry of live threads.
+ *
+ * @details
+ * `set_current_thread_name(name)` hands the name to the kernel with
+ * `pthread_setname_np`, so `top -H`, `ps -L`, `perf` and gdb show it
+ * (the kernel keeps 15 characters).
+ *
+ * A `thread_registration` object (usually the first local of a thread
+ * function) names the thread and claims a slot in a fixed table of
+ * `max_registered_threads` cache-line-sized slots; its destructor frees
+ * the slot. Claiming is a CAS on the slot's `used` flag, so registration,
+ * state changes and snapshots never take a lock. When the table is full
+ * the thread is still named but not tracked.
+ *
+ * `thread_snapshot()` copies every live slot: name, kernel tid, start
+ * time, CPU time and state. A slot is written under a per-slot sequence
+ * counter (odd while being written), and the reader retries if the counter
+ * moved, so it never sees half of one thread and half of another. CPU time
+ * comes from the target thread's CLOCK_THREAD_CPUTIME_ID equivalent
+ * (a clockid built from its tid, as glibc's pthread_getcpuclockid does),
+ * which works without the target's cooperation.
+ *
+ * `set_current_thread_state()` is a relaxed store into the caller's slot
+ * and costs nothing measurable.
+ *
+ * @code
+ * std::jthread worker([] {
+ *     async::thread_registration reg("io-worker-3");
+ *     async::set_current_thread_state(async::thread_state::blocked);
+ *     ...
+ * });
+ * async::dump_threads(std::cout);
+ * @endcode
+ */
+
+namespace async {
+
+enum class thread_state : std::uint8_t { running, idle, blocked, stopping };
+
+inline constexpr std::size_t max_registered_threads = 1024;
+inline constexpr std::size_t thread_name_capacity = 16;   // including the terminator
+
+struct thread_info {
+    std::string name;
+    pid_t tid;
+    std::chrono::steady_clock::time_point started;
+    std::chrono::nanoseconds cpu_time;   // -1ns if the thread exited meanwhile
+    thread_state state;
+};
+
+inline const char* to_string(thread_state s) {
+    switch (s) {
+        case thread_state::running: return "running";
+        case thread_state::idle: return "idle";
+        case thread_state::blocked: return "blocked";
+        case thread_state::stopping: return "stopping";
+    }
+    return "?";
+}
+
+namespace detail {
+
+struct alignas(cache_line_size) thread_slot {
+    std::atomic<bool> used{false};
+    std::atomic<std::uint32_t> seq{0};
+    std::array<std::atomic<std::uint64_t>, thread_name_capacity / 8> name{};
+    std::atomic<pid_t> tid{0};
+    std::atomic<std::int64_t> started_ns{0};
+    std::atomic<thread_state> state{thread_state::running};
+};
+
+inline std::array<thread_slot, max_registered_threads> thread_table;
+inline thread_local thread_slot* current_thread_slot = nullptr;
+
+inline pid_t current_tid() { return static_cast<pid_t>(::syscall(SYS_gettid)); }
+
+// Per-thread CPU clock of another thread in the process (see clock_getcpuclockid(3))
+inline std::chrono::nanoseconds thread_cpu_time(pid_t tid) {
+    const clockid_t cid = static_cast<clockid_t>((~static_cast<clockid_t>(tid) << 3) | 6);
+    timespec ts{};
+    if (::clock_gettime(cid, &ts) != 0) return std::chrono::nanoseconds(-1);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+inline void store_name(thread_slot& slot, std::string_view name) {
+    char buf[thread_name_capacity] = {};
+    std::memcpy(buf, name.data(), std::min(name.size(), thread_name_capacity - 1));
+    for (std::size_t w = 0; w < slot.name.size(); ++w) {
+        std::uint64_t word;
+        std::memcpy(&word, buf + 8 * w, 8);
+        slot.name[w].store(word, std::memory_order_relaxed);
+    }
+}
+
+inline std::string load_name(const thread_slot& slot) {
+    char buf[thread_name_capacity];
+    for (std::size_t w = 0; w < slot.name.size(); ++w) {
+        const std::uint64_t word = slot.name[w].load(std::memory_order_relaxed);
+        std::memcpy(buf + 8 * w, &word, 8);
+    }
+    buf[thread_name_capacity - 1] = '\0';
+    return buf;
+}
+
+} // namespace detail
+
+// Names the calling thread for the kernel (and its registry slot, if any)
+inline void set_current_thread_name(std::string_view name) {
+    char buf[thread_name_capacity] = {};
+    std::memcpy(buf, name.data(), std::min(name.size(), thread_name_capacity - 1));
+    ::pthread_setname_np(::pthread_self(), buf);
+
+    if (auto* slot = detail::current_thread_slot) {
+        slot->seq.fetch_add(1, std::memory_order_acq_rel);
+        detail::store_name(*slot, name);
+        slot->seq.fetch_add(1, std::memory_order_release);
+    }
+}
+
+inline void set_current_thread_state(thread_state s) {
+    if (auto* slot = detail::current_thread_slot) slot->state.store(s, std::memory_order_relaxed);
+}
+
+class thread_registration {
+public:
+    explicit thread_registration(std::string_view name) {
+        for (auto& slot : detail::thread_table) {
+            bool expected = false;
+            if (slot.used.load(std::memory_order_relaxed) ||
+                !slot.used.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                continue;
+            }
+            slot.seq.fetch_add(1, std::memory_order_acq_rel);   // odd: being written
+            detail::store_name(slot, name);
+            slot.tid.store(detail::current_tid(), std::memory_order_relaxed);
+            slot.started_ns.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                  std::memory_order_relaxed);
+            slot.state.store(thread_state::running, std::memory_order_relaxed);
+            slot.seq.fetch_add(1, std::memory_order_release);
+            mine = &slot;
+            break;
+        }
+        previous = std::exchange(detail::current_thread_slot, mine);
+        set_current_thread_name(name);
+    }
+
+    ~thread_registration() {
+        detail::current_thread_slot = previous;
+        if (!mine) return;
+        mine->seq.fetch_add(1, std::memory_order_acq_rel);
+        mine->used.store(false, std::memory_order_release);
+        mine->seq.fetch_add(1, std::memory_order_release);
+    }
+
+    thread_registration(const thread_registration&) = delete;
+    thread_registration& operator=(const thread_registration&) = delete;
+
+    bool tracked() const { return mine != nullptr; }
+
+private:
+    detail::thread_slot* mine = nullptr;
+    detail::thread_slot* previous = nullptr;
+};
+
+// Copies every registered thread; lock-free, safe while threads come and go
+inline std::vector<thread_info> thread_snapshot() {
+    std::vector<thread_info> out;
+    for (const auto& slot : detail::thread_table) {
+        if (!slot.used.load(std::memory_order_acquire)) continue;
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            const std::uint32_t before = slot.seq.load(std::memory_order_acquire);
+            if (before & 1) continue;   // being written
+            thread_info info;
+            const bool used = slot.used.load(std::memory_order_relaxed);
+            info.name = detail::load_name(slot);
+            info.tid = slot.tid.load(std::memory_order_relaxed);
+            info.started = std::chrono::steady_clock::time_point(
+                std::chrono::steady_clock::duration(slot.started_ns.load(std::memory_order_relaxed)));
+            info.state = slot.state.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != before) continue;
+            if (used) {
+                info.cpu_time = detail::thread_cpu_time(info.tid);
+                out.push_back(std::move(info));
+            }
+            break;
+        }
+    }
+    return out;
+}
+
+inline void dump_threads(std::ostream& os, const std::vector<thread_info>& threads = thread_snapshot()) {
+    const auto now = std::chrono::steady_clock::now();
+    const auto flags = os.flags();
+    os << std::left << std::setw(16) << "NAME" << std::right << std::setw(8) << "TID" << std::setw(12) << "UPTIME ms"
+       << std::setw(12) << "CPU ms" << "  STATE\n";
+    for (const auto& t : threads) {
+        os << std::left << std::setw(16) << t.name << std::right << std::setw(8) << t.tid << std::setw(12)
+           << std::chrono::duration_cast<std::chrono::milliseconds>(now - t.started).count() << std::setw(12)
+           << std::fixed << std::setprecision(1) << std::chrono::duration<double, std::milli>(t.cpu_time).count()
+           << "  " << to_string(t.state) << '\n';
+    }
+    os.flags(flags);
+}
+
+} // namespace async
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+/**
+ * @brief Hierarchical timing wheel driven by one thread.
+ *
+ * @details
+ * 04_identify_thread.cpp, 07_daemon_threads.cpp and 09_move_threads.cpp
+ * express timed work as `sleep_for`, parking a whole OS thread per timer.
+ * A timer wheel keeps any number of timers in one structure and fires
+ * them from a single driver thread.
+ *
+ * Layout (the classic Linux "timer vector" design):
+ * - Time is measured in ticks of `resolution` (default 1ms).
+ * - Four levels of 256 slots. Level 0 holds timers due within 256 ticks,
+ *   level 1 within 2^16 ticks, level 2 within 2^24, level 3 the rest
+ *   (up to 2^32 ticks, about 49 days at 1ms).
+ * - Each slot is an intrusive doubly-linked list of timer nodes kept in
+ *   one vector with a free list, so insert and cancel are O(1) and do not
+ *   allocate once the vector has grown (the callback itself may).
+ * - Every 256 ticks the next slot of the level above is cascaded down;
+ *   a timer is moved at most three times in its life.
+ *
+ * Handles carry a generation count, so cancelling a timer that already
+ * fired (and whose node was reused) is a safe no-op.
+ *
+ * Expired callbacks are collected under the lock and run after it is
+ * released: submitted to `pool` if one was given, otherwise inline on the
+ * driver thread (keep those short). The driver sleeps until the next tick
+ * boundary, computed from the start time so ticks do not drift, and parks
+ * indefinitely while no timers are pending.
+ *
+ * @code
+ * async::thread_pool pool;
+ * async::timer_wheel timers(1ms, &pool);
+ * auto id = timers.schedule_after(3s, [] { sync_cout << "fired\n"; });
+ * timers.cancel(id);
+ * @endcode
+ */
+
+namespace async {
+
+class timer_wheel {
+public:
+    using clock = std::chrono::steady_clock;
+    using timer_id = std::uint64_t;   // generation << 32 | node index
+
+    static constexpr timer_id invalid_timer = 0;
+
+    explicit timer_wheel(std::chrono::microseconds resolution = std::chrono::milliseconds(1),
+                         thread_pool* pool = nullptr)
+        : tick_length(resolution), executor(pool), start(clock::now()) {
+        for (auto& level : wheel) level.fill(nil);
+        driver = std::jthread([this](std::stop_token st) { run(st); });
+    }
+
+    // Stops the driver; timers that have not fired are dropped
+    ~timer_wheel() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);   // the driver is either waiting or sees the stop
+            driver.request_stop();
+        }
+        cv.notify_all();
+    }
+
+    timer_wheel(const timer_wheel&) = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+
+    template <class F>
+    timer_id schedule_at(clock::time_point when, F&& fn) {
+        timer_id id;
+        bool was_idle;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            // An empty wheel skips its idle stretch instead of replaying it tick by tick
+            if (active == 0) current_tick = std::max(current_tick, to_tick(clock::now()));
+            const std::uint32_t idx = allocate();
+            node& n = nodes[idx];
+            n.fn = task(std::forward<F>(fn));
+            n.expires = std::max(to_tick(when), current_tick);
+            link(idx);
+            id = make_id(idx);
+            was_idle = active++ == 0;
+        }
+        if (was_idle) cv.notify_one();
+        return id;
+    }
+
+    template <class Rep, class Period, class F>
+    timer_id schedule_after(std::chrono::duration<Rep, Period> delay, F&& fn) {
+        return schedule_at(clock::now() + delay, std::forward<F>(fn));
+    }
+
+    /**
+     * Cancelled as soon as `st` is stopped (its node is freed right away,
+     * not at expiry), and never runs `fn` after the stop. Stop requests
+     * must not race the wheel's destruction.
+     */
+    template <class F>
+    timer_id schedule_at(clock::time_point when, F&& fn, std::stop_token st) {
+        if (st.stop_requested()) return invalid_timer;
+        auto link = std::make_shared<stop_link>(st);
+        const timer_id id = schedule_at(when, [link, fn = std::forward<F>(fn)] () mutable {
+            if (!link->token.stop_requested()) fn();
+        });
+        link->on_stop.emplace(std::move(st), cancel_on_stop{this, id});
+        return id;
+    }
+
+    template <class Rep, class Period, class F>
+    timer_id schedule_after(std::chrono::duration<Rep, Period> delay, F&& fn, std::stop_token st) {
+        return schedule_at(clock::now() + delay, std::forward<F>(fn), std::move(st));
+    }
+
+    // False if the timer already fired, was cancelled, or is unknown
+    bool cancel(timer_id id) {
+        task victim;   // destroyed outside the lock
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            const auto idx = static_cast<std::uint32_t>(id & 0xffffffff);
+            if (id == invalid_timer || idx >= nodes.size()) return false;
+            node& n = nodes[idx];
+            if (!n.armed || n.generation != static_cast<std::uint32_t>(id >> 32)) return false;
+            unlink(idx);
+            victim = std::move(n.fn);
+            release(idx);
+            --active;
+        }
+        return true;
+    }
+
+    std::size_t pending() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return active;
+    }
+
+    std::chrono::microseconds resolution() const { return tick_length; }
+
+    // Bytes held by the node table (callbacks' own allocations not included)
+    std::size_t node_memory() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return nodes.capacity() * sizeof(node);
+    }
+
+private:
+    static constexpr std::uint32_t nil = 0xffffffff;
+    static constexpr int level_bits = 8;
+    static constexpr std::size_t slots = std::size_t{1} << level_bits;
+    static constexpr std::uint64_t slot_mask = slots - 1;
+    static constexpr int levels = 4;
+
+    struct cancel_on_stop {
+        timer_wheel* wheel;
+        timer_id id;
+        void operator()() const { wheel->cancel(id); }
+    };
+
+    // Shared by the scheduled callback and nothing else: freeing the node
+    // (fire or cancel) drops the stop_callback with it
+    struct stop_link {
+        explicit stop_link(std::stop_token t) : token(std::move(t)) {}
+        std::stop_token token;
+        std::optional<std::stop_callback<cancel_on_stop>> on_stop;
+    };
+
+    struct node {
+        task fn;
+        std::uint64_t expires = 0;
+        std::uint32_t prev = nil;
+        std::uint32_t next = nil;
+        std::uint32_t generation = 1;
+        std::uint16_t level = 0;
+        std::uint16_t slot = 0;
+        bool armed = false;
+    };
+
+    std::uint64_t to_tick(clock::time_point tp) const {
+        if (tp <= start) return 0;
+        return static_cast<std::uint64_t>((tp - start) / tick_length);
+    }
+
+    timer_id make_id(std::uint32_t idx) const {
+        return (static_cast<timer_id>(nodes[idx].generation) << 32) | idx;
+    }
+
+    std::uint32_t allocate() {
+        if (free_head != nil) {
+            const std::uint32_t idx = free_head;
+            free_head = nodes[idx].next;
+            return idx;
+        }
+        nodes.emplace_back();
+        return static_cast<std::uint32_t>(nodes.size() - 1);
+    }
+
+    void release(std::uint32_t idx) {
+        node& n = nodes[idx];
+        n.armed = false;
+        ++n.generation;
+        n.next = free_head;
+        free_head = idx;
+    }
+
+    // Places node idx in the slot matching its distance from current_tick
+    void link(std::uint32_t idx) {
+        node& n = nodes[idx];
+        const std::uint64_t delta = n.expires - current_tick;
+        int level = 0;
+        while (level < levels - 1 && delta >= (std::uint64_t{1} << (level_bits * (level + 1)))) ++level;
+
+        std::uint64_t expires = n.expires;
+        if (level == levels - 1 && delta >= (std::uint64_t{1} << (level_bits * levels))) {
+            expires = current_tick + (std::uint64_t{1} << (level_bits * levels)) - 1;   // clamp
+        }
+        n.level = static_cast<std::uint16_t>(level);
+        n.slot = static_cast<std::uint16_t>((expires >> (level_bits * level)) & slot_mask);
+        n.armed = true;
+
+        std::uint32_t& head = wheel[level][n.slot];
+        n.prev = nil;
+        n.next = head;
+        if (head != nil) nodes[head].prev = idx;
+        head = idx;
+    }
+
+    void unlink(std::uint32_t idx) {
+        node& n = nodes[idx];
+        if (n.prev != nil) {
+            nodes[n.prev].next = n.next;
+        } else {
+            wheel[n.level][n.slot] = n.next;
+        }
+        if (n.next != nil) nodes[n.next].prev = n.prev;
+        n.prev = n.next = nil;
+    }
+
+    // Re-links every timer of wheel[level][slot] one level down
+    void cascade(int level, std::size_t slot) {
+        std::uint32_t idx = std::exchange(wheel[level][slot], nil);
+        while (idx != nil) {
+            const std::uint32_t next = nodes[idx].next;
+            link(idx);
+            idx = next;
+        }
+    }
+
+    // Advances one tick, moving due callbacks into `due`
+    void tick(std::vector<task>& due) {
+        const std::size_t idx = current_tick & slot_mask;
+        if (idx == 0) {
+            for (int level = 1; level < levels; ++level) {
+                const std::size_t upper = (current_tick >> (level_bits * level)) & slot_mask;
+                cascade(level, upper);
+                if (upper != 0) break;
+            }
+        }
+
+        std::uint32_t n = std::exchange(wheel[0][idx], nil);
+        while (n != nil) {
+            const std::uint32_t next = nodes[n].next;
+            due.push_back(std::move(nodes[n].fn));
+            release(n);
+            --active;
+            n = next;
+        }
+        ++current_tick;
+    }
+
+    void run(std::stop_token st) {
+        std::vector<task> due;
+        std::unique_lock<std::mutex> lock(mtx);
+        while (!st.stop_requested()) {
+            if (active == 0) {
+                cv.wait(lock, [&] { return active > 0 || st.stop_requested(); });
+                continue;
+            }
+
+            const auto next_boundary = start + tick_length * static_cast<std::int64_t>(current_tick + 1);
+            if (clock::now() < next_boundary) {
+                cv.wait_until(lock, next_boundary, [&] { return st.stop_requested(); });
+                continue;
+            }
+
+            // Catch up on every tick that has elapsed
+            const std::uint64_t target = to_tick(clock::now());
+            while (current_tick < target && active > 0) tick(due);
+            if (active == 0) current_tick = target;
+
+            if (!due.empty()) {
+                lock.unlock();
+                for (auto& fn : due) {
+                    if (executor) {
+                        executor->submit(std::move(fn));
+                    } else {
+                        fn();
+                    }
+                }
+                due.clear();
+                lock.lock();
+            }
+        }
+    }
+
+    const std::chrono::microseconds tick_length;
+    thread_pool* const executor;
+    const clock::time_point start;
+
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    std::array<std::array<std::uint32_t, slots>, levels> wheel;
+    std::vector<node> nodes;
+    std::uint32_t free_head = nil;
+    std::uint64_t current_tick = 0;
+    std::size_t active = 0;
+
+    std::jthread driver;   // last: starts after everything above is initialized
+};
+
+} // namespace async
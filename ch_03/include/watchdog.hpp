@@ -0,0 +1,364 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <syncstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <execinfo.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "cache_line.hpp"
+#include "thread_registry.hpp"
+
+/**
+ * @brief Watchdog for threads that stop making progress.
+ *
+ * @details
+ * A watched thread holds a `watchdog::heartbeat` and calls `beat()` at
+ * progress points (once per loop iteration, per task, ...). `beat()` is a
+ * single relaxed store of a thread-private counter into a slot on its own
+ * cache line; nothing is read and nothing is shared with other writers.
+ *
+ * A monitor thread samples every slot each `interval`. A thread whose
+ * counter has not moved for `stall_after` is reported once per episode:
+ * - `stall_kind::spinning` if, over the last sampling interval, its CPU
+ *   time grew by at least `spin_cpu_ratio` of the wall time (a busy loop,
+ *   livelock, or spinning on a lock),
+ * - `stall_kind::blocked` otherwise (a lost wakeup, a deadlock, a long
+ *   syscall).
+ *
+ * Each report carries name, tid, stall time, CPU time burnt during the
+ * stall and, if `capture_backtrace` is set, the thread's stack: the
+ * monitor sends `SIGRTMIN + 3` to that one thread (tgkill), whose handler
+ * records `backtrace()` into the slot; the monitor symbolizes it. Each
+ * request carries a sequence number that the handler claims before
+ * writing, so a handler arriving after the monitor gave up never
+ * overwrites a later capture. The handler is installed with SA_RESTART so
+ * interrupted system calls resume. Link with -rdynamic to get function
+ * names instead of bare addresses.
+ *
+ * Registration and the monitor's scan share a mutex; heartbeats never
+ * touch it, and backtraces and `on_stall` run after the scan has released
+ * it. Slots are shared between the heartbeat and the watchdog, and a
+ * heartbeat refers to its watchdog weakly, so either may outlive the
+ * other. One thread may hold several heartbeats (nested `watch()` calls);
+ * they are chained per thread, and releasing one in any order leaves the
+ * others able to answer backtrace requests. The default `on_stall` prints the report to std::cerr.
+ *
+ * @code
+ * async::watchdog dog({.stall_after = 500ms});
+ * std::jthread worker([&](std::stop_token st) {
+ *     auto hb = dog.watch("worker");
+ *     while (!st.stop_requested()) {
+ *         hb.beat();
+ *         process_next();
+ *     }
+ * });
+ * @endcode
+ */
+
+namespace async {
+
+enum class stall_kind { blocked, spinning };
+
+struct stall_report {
+    std::string name;
+    pid_t tid;
+    stall_kind kind;
+    std::chrono::milliseconds stalled_for;
+    std::chrono::milliseconds cpu_during_stall;
+    std::vector<std::string> backtrace;
+};
+
+inline const char* to_string(stall_kind k) { return k == stall_kind::spinning ? "spinning" : "blocked"; }
+
+struct watchdog_options {
+    std::chrono::milliseconds interval{100};
+    std::chrono::milliseconds stall_after{1000};
+    double spin_cpu_ratio = 0.8;
+    bool capture_backtrace = true;
+    std::function<void(const stall_report&)> on_stall{};   // empty = print to std::cerr
+};
+
+namespace detail {
+
+inline constexpr int max_backtrace_frames = 32;
+
+struct alignas(cache_line_size) heartbeat_slot {
+    std::atomic<std::uint64_t> beats{0};   // written only by the owner, alone on this line
+
+    alignas(cache_line_size) std::string name;
+    pid_t tid = 0;
+    heartbeat_slot* outer = nullptr;   // the thread's previous heartbeat; owner only
+
+    // Monitor-side bookkeeping
+    std::uint64_t last_beats = 0;
+    std::chrono::steady_clock::time_point last_progress;
+    std::chrono::nanoseconds cpu_at_progress{0};
+    std::chrono::steady_clock::time_point last_sample;
+    std::chrono::nanoseconds cpu_at_sample{0};
+    bool reported = false;
+
+    // Backtrace requests: the monitor posts a sequence number in
+    // `capture_request`, the handler claims it (exchange with 0), fills
+    // `frames` and publishes the number in `capture_done`
+    std::uint64_t capture_seq = 0;   // monitor only
+    std::atomic<std::uint64_t> capture_request{0};
+    std::atomic<std::uint64_t> capture_done{0};
+    std::array<void*, max_backtrace_frames> frames{};
+    int frame_count = 0;
+};
+
+struct watch_list {
+    std::mutex mtx;
+    std::vector<std::shared_ptr<heartbeat_slot>> slots;
+
+    void remove(const heartbeat_slot* slot) {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::erase_if(slots, [&](const auto& s) { return s.get() == slot; });
+    }
+};
+
+// Innermost heartbeat of this thread; the rest are chained through `outer`
+inline thread_local heartbeat_slot* current_heartbeat = nullptr;
+
+// Unlinks `slot` from the calling thread's chain, wherever it is
+inline void unlink_heartbeat(heartbeat_slot* slot) noexcept {
+    if (current_heartbeat == slot) {
+        current_heartbeat = slot->outer;
+        return;
+    }
+    for (auto* s = current_heartbeat; s; s = s->outer) {
+        if (s->outer == slot) {
+            s->outer = slot->outer;
+            return;
+        }
+    }
+}
+
+inline void backtrace_handler(int) {
+    const int saved = errno;
+    for (auto* slot = current_heartbeat; slot; slot = slot->outer) {
+        if (const std::uint64_t seq = slot->capture_request.exchange(0, std::memory_order_acquire)) {
+            slot->frame_count = ::backtrace(slot->frames.data(), max_backtrace_frames);
+            slot->capture_done.store(seq, std::memory_order_release);
+        }
+    }
+    errno = saved;
+}
+
+inline constexpr int skipped_frames = 2;   // the handler and the signal trampoline
+
+inline int backtrace_signal() { return SIGRTMIN + 3; }
+
+inline void install_backtrace_handler() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        void* warmup[1];
+        ::backtrace(warmup, 1);   // loads libgcc now, not inside the handler
+
+        struct sigaction sa{};
+        sa.sa_handler = backtrace_handler;
+        sigemptyset(&sa.sa_mask);
+        sa.sa_flags = SA_RESTART;
+        ::sigaction(backtrace_signal(), &sa, nullptr);
+    });
+}
+
+} // namespace detail
+
+class watchdog {
+public:
+    using clock = std::chrono::steady_clock;
+
+    class heartbeat {
+    public:
+        heartbeat() = default;
+        heartbeat(heartbeat&& other) noexcept
+            : owner(std::move(other.owner)), slot(std::move(other.slot)), count(other.count) {}
+        heartbeat& operator=(heartbeat&& other) noexcept {
+            if (this != &other) {
+                release();
+                owner = std::move(other.owner);
+                slot = std::move(other.slot);
+                count = other.count;
+            }
+            return *this;
+        }
+        ~heartbeat() { release(); }
+
+        // One relaxed store
+        void beat() noexcept {
+            if (slot) slot->beats.store(++count, std::memory_order_relaxed);
+        }
+
+    private:
+        friend class watchdog;
+        heartbeat(std::weak_ptr<detail::watch_list> w, std::shared_ptr<detail::heartbeat_slot> s)
+            : owner(std::move(w)), slot(std::move(s)) {}
+
+        // Runs on the watched thread, which owns `current_heartbeat`
+        void release() {
+            if (!slot) return;
+            if (auto list = owner.lock()) list->remove(slot.get());
+            detail::unlink_heartbeat(slot.get());   // a nested watch() restores the outer one
+            std::atomic_signal_fence(std::memory_order_seq_cst);   // before the slot may be freed
+            owner.reset();
+            slot.reset();
+        }
+
+        std::weak_ptr<detail::watch_list> owner;   // a no-op once the watchdog is gone
+        std::shared_ptr<detail::heartbeat_slot> slot;
+        std::uint64_t count = 0;
+    };
+
+    explicit watchdog(watchdog_options opts = {}) : options(std::move(opts)) {
+        if (options.capture_backtrace) detail::install_backtrace_handler();
+        monitor = std::jthread([this](std::stop_token st) { run(st); });
+    }
+
+    ~watchdog() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            monitor.request_stop();
+        }
+        cv.notify_all();
+    }
+
+    watchdog(const watchdog&) = delete;
+    watchdog& operator=(const watchdog&) = delete;
+
+    // Registers the calling thread; the heartbeat must stay on that thread
+    heartbeat watch(std::string_view name) {
+        auto slot = std::make_shared<detail::heartbeat_slot>();
+        slot->name = std::string(name);
+        slot->tid = detail::current_tid();
+        slot->last_progress = slot->last_sample = clock::now();
+        slot->cpu_at_progress = slot->cpu_at_sample = detail::thread_cpu_time(slot->tid);
+        {
+            std::lock_guard<std::mutex> lock(watched->mtx);
+            watched->slots.push_back(slot);
+        }
+        slot->outer = detail::current_heartbeat;
+        detail::current_heartbeat = slot.get();
+        return heartbeat(watched, std::move(slot));
+    }
+
+private:
+    struct stall {
+        stall_report report;
+        std::shared_ptr<detail::heartbeat_slot> slot;   // keeps it alive past unregistration
+    };
+
+    void run(std::stop_token st) {
+        std::vector<stall> stalls;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                if (cv.wait_for(lock, options.interval, [&] { return st.stop_requested(); })) return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(watched->mtx);
+                const auto now = clock::now();
+                for (auto& s : watched->slots) {
+                    if (auto report = sample(*s, now)) stalls.push_back({std::move(*report), s});
+                }
+            }
+            // Signalling and waiting for the handler must not block watch() and thread exits
+            for (auto& [report, slot] : stalls) {
+                if (options.capture_backtrace) report.backtrace = capture(*slot);
+                publish(report);
+            }
+            stalls.clear();
+        }
+    }
+
+    // Monitor thread only; the slot's fields it reads were set before registration
+    std::optional<stall_report> sample(detail::heartbeat_slot& s, clock::time_point now) {
+        const std::uint64_t beats = s.beats.load(std::memory_order_relaxed);
+        const auto cpu = detail::thread_cpu_time(s.tid);
+        const auto since_sample = now - std::exchange(s.last_sample, now);
+        const auto cpu_since_sample = cpu - std::exchange(s.cpu_at_sample, cpu);
+        if (beats != s.last_beats) {
+            s.last_beats = beats;
+            s.last_progress = now;
+            s.cpu_at_progress = cpu;
+            s.reported = false;
+            return std::nullopt;
+        }
+        const auto stalled = now - s.last_progress;
+        if (s.reported || stalled < options.stall_after) return std::nullopt;
+        s.reported = true;
+
+        // Judged on the latest interval: a thread may block first and spin later
+        const bool spinning = cpu_since_sample >= since_sample * options.spin_cpu_ratio;
+        return stall_report{s.name, s.tid, spinning ? stall_kind::spinning : stall_kind::blocked,
+                            std::chrono::duration_cast<std::chrono::milliseconds>(stalled),
+                            std::chrono::duration_cast<std::chrono::milliseconds>(cpu - s.cpu_at_progress), {}};
+    }
+
+    std::vector<std::string> capture(detail::heartbeat_slot& s) {
+        // A handler that claimed an earlier, timed-out request may still be writing `frames`
+        if (s.capture_done.load(std::memory_order_acquire) != s.capture_seq) return {};
+
+        const std::uint64_t seq = ++s.capture_seq;
+        s.capture_request.store(seq, std::memory_order_release);
+        if (::syscall(SYS_tgkill, ::getpid(), s.tid, detail::backtrace_signal()) == 0) {
+            const auto give_up = clock::now() + std::chrono::milliseconds(50);
+            while (s.capture_done.load(std::memory_order_acquire) != seq && clock::now() < give_up) {
+                std::this_thread::yield();
+            }
+        }
+        if (s.capture_done.load(std::memory_order_acquire) != seq) {
+            // Withdraw the request; if the handler already claimed it, the next capture waits for it
+            std::uint64_t expected = seq;
+            if (s.capture_request.compare_exchange_strong(expected, 0, std::memory_order_relaxed)) {
+                s.capture_done.store(seq, std::memory_order_relaxed);
+            }
+            return {};
+        }
+
+        const int n = s.frame_count;
+        std::vector<std::string> frames;
+        char** symbols = ::backtrace_symbols(s.frames.data(), n);
+        for (int i = detail::skipped_frames; i < n; ++i) frames.emplace_back(symbols ? symbols[i] : "?");
+        std::free(symbols);
+        return frames;
+    }
+
+    void publish(const stall_report& r) {
+        if (options.on_stall) {
+            options.on_stall(r);
+            return;
+        }
+        std::osyncstream out(std::cerr);
+        out << "watchdog: thread '" << r.name << "' (tid " << r.tid << ") " << to_string(r.kind) << " for "
+            << r.stalled_for.count() << "ms, " << r.cpu_during_stall.count() << "ms CPU\n";
+        for (const auto& f : r.backtrace) out << "    " << f << '\n';
+    }
+
+    watchdog_options options;
+    std::mutex mtx;   // the monitor's sleep
+    std::condition_variable cv;
+    std::shared_ptr<detail::watch_list> watched = std::make_shared<detail::watch_list>();
+    std::jthread monitor;   // last: stops before the members it uses go away
+};
+
+} // namespace async